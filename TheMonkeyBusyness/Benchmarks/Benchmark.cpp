@@ -0,0 +1,120 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> g_allocations{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace Benchmark {
+
+uint64_t AllocationCount()
+{
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+void State::PauseTiming()
+{
+    m_pauseStart = std::chrono::steady_clock::now();
+    m_pauseAllocations = AllocationCount();
+}
+
+void State::ResumeTiming()
+{
+    m_pausedAllocations += AllocationCount() - m_pauseAllocations;
+    m_paused += std::chrono::steady_clock::now() - m_pauseStart;
+}
+
+void State::SetCounter(const std::string& name, double value)
+{
+    m_counterName = name;
+    m_counterValue = value;
+}
+
+struct Runner
+{
+    static Result Measure(const std::string& name, const Body& body, uint64_t iterations)
+    {
+        State state(iterations);
+        uint64_t allocationsBefore = AllocationCount();
+        auto start = std::chrono::steady_clock::now();
+        body(state);
+        auto elapsed = std::chrono::steady_clock::now() - start - state.m_paused;
+        uint64_t allocations = AllocationCount() - allocationsBefore - state.m_pausedAllocations;
+
+        double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        return Result{ name, iterations, nanoseconds / iterations, static_cast<double>(allocations) / iterations,
+            state.m_counterName, state.m_counterValue };
+    }
+};
+
+Result Run(const std::string& name, const Body& body, std::chrono::milliseconds minTime)
+{
+    const double budget = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(minTime).count());
+    uint64_t iterations = 1;
+    while (true) {
+        Result result = Runner::Measure(name, body, iterations);
+        double total = result.nsPerOp * iterations;
+        if (total >= budget || iterations >= (1ull << 30)) {
+            return result;
+        }
+        // Aim a bit past the budget so the final run usually is the next one
+        double scale = total > 0 ? budget * 1.2 / total : 100.0;
+        iterations = static_cast<uint64_t>(iterations * std::min(std::max(scale, 2.0), 100.0));
+    }
+}
+
+void PrintHeader()
+{
+    std::printf("%-40s %12s %14s %12s  %s\n", "benchmark", "iterations", "ns/op", "allocs/op", "counter");
+}
+
+void Print(const Result& result)
+{
+    std::printf("%-40s %12llu %14.1f %12.2f", result.name.c_str(), static_cast<unsigned long long>(result.iterations),
+        result.nsPerOp, result.allocationsPerOp);
+    if (!result.counterName.empty()) {
+        std::printf("  %s=%.0f", result.counterName.c_str(), result.counterValue);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness: times a body over enough iterations to fill a time budget and
+// counts heap allocations made while the clock is running (global operator new is replaced
+// in Benchmark.cpp).
+namespace Benchmark {
+
+uint64_t AllocationCount();
+
+class State
+{
+public:
+    explicit State(uint64_t iterations) : m_iterations{ iterations } {}
+
+    uint64_t Iterations() const { return m_iterations; }
+
+    // Excludes per-iteration setup (refilling bullets, resetting state) from time and allocations
+    void PauseTiming();
+    void ResumeTiming();
+
+    // Extra value shown next to the timing, e.g. bytes per snapshot
+    void SetCounter(const std::string& name, double value);
+
+private:
+    friend struct Runner;
+
+    uint64_t m_iterations;
+    std::chrono::steady_clock::duration m_paused{};
+    uint64_t m_pausedAllocations = 0;
+    std::chrono::steady_clock::time_point m_pauseStart;
+    uint64_t m_pauseAllocations = 0;
+    std::string m_counterName;
+    double m_counterValue = 0;
+};
+
+using Body = std::function<void(State&)>;
+
+struct Result
+{
+    std::string name;
+    uint64_t iterations;
+    double nsPerOp;
+    double allocationsPerOp;
+    std::string counterName;
+    double counterValue;
+};
+
+// Runs body with growing iteration counts until one run takes at least minTime
+Result Run(const std::string& name, const Body& body, std::chrono::milliseconds minTime);
+
+void PrintHeader();
+void Print(const Result& result);
+
+// Keeps the optimizer from dropping a computed value
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+}
@@ -0,0 +1,319 @@
+#include "Benchmark.h"
+#include "Arena.h"
+#include "GameState.h"
+#include "InputCodec.h"
+#include "Raycast.h"
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#ifdef MONKEY_BENCH_JSON
+#include <crow.h>
+#endif
+#ifdef MONKEY_BENCH_USERS
+#include "User.h"
+#include "UserDatabase.h"
+#endif
+
+namespace {
+
+constexpr auto kMinTime = std::chrono::milliseconds(300);
+constexpr float kFrameTime = GameConfig::kFrameDurationMs / 1000.0f;
+
+// The game and database code log to cout/cerr on many paths, keep that out of the results
+class QuietScope
+{
+public:
+    QuietScope() : m_out{ std::cout.rdbuf(m_sink.rdbuf()) }, m_err{ std::cerr.rdbuf(m_sink.rdbuf()) } {}
+    ~QuietScope()
+    {
+        std::cout.rdbuf(m_out);
+        std::cerr.rdbuf(m_err);
+    }
+
+private:
+    std::ostringstream m_sink;
+    std::streambuf* m_out;
+    std::streambuf* m_err;
+};
+
+// Deterministic positions and directions so runs are comparable
+struct BenchRandom
+{
+    uint64_t state;
+
+    float Next()
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<float>(state >> 40) / static_cast<float>(1ull << 24);
+    }
+};
+
+// A game with players at distinct spawns that fire without cooldown, so bullets can be topped up every frame
+class BenchGame
+{
+public:
+    BenchGame(int players, uint64_t seed) : m_state(std::make_shared<Arena>(GameConfig::kArenaDim, GameConfig::kArenaSpawns, seed))
+    {
+        QuietScope quiet;
+        for (int id = 1; id <= players; ++id) {
+            m_state.AddPlayer(id);
+            m_state.SetResolution(GameConfig::kScreenWidth, GameConfig::kScreenHeight, id);
+            Player* player = m_state.GetPlayer(id);
+            player->m_weapon.SetFireRate(0.0f);
+            m_health.push_back(player->GetCharacter()->GetHealth());
+        }
+    }
+
+    GameState& State() { return m_state; }
+
+    // Heals everyone and refills the bullet buffer up to count, bullets hitting walls disappear every frame
+    void Refill(size_t bullets)
+    {
+        int players = static_cast<int>(m_health.size());
+        for (int id = 1; id <= players; ++id) {
+            m_state.GetPlayer(id)->GetCharacter()->SetHealth(m_health[id - 1]);
+        }
+        int id = 0;
+        int misses = 0;
+        while (m_state.GetBulletCount() < bullets && misses < players) {
+            size_t before = m_state.GetBulletCount();
+            m_state.ProcessShoot(id + 1, { m_random.Next() * GameConfig::kScreenWidth, m_random.Next() * GameConfig::kScreenHeight });
+            misses = m_state.GetBulletCount() > before ? 0 : misses + 1;
+            id = (id + 1) % players;
+        }
+    }
+
+private:
+    GameState m_state;
+    std::vector<int> m_health;
+    BenchRandom m_random{ 42 };
+};
+
+void BenchArenaGeneration(std::vector<Benchmark::Result>& results, int dim)
+{
+    results.push_back(Benchmark::Run("Arena/Generate/" + std::to_string(dim), [dim](Benchmark::State& state) {
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            Arena arena(dim, GameConfig::kArenaSpawns, i + 1);
+            Benchmark::DoNotOptimize(arena);
+        }
+    }, kMinTime));
+}
+
+void BenchRaycast(std::vector<Benchmark::Result>& results)
+{
+    auto arena = std::make_shared<Arena>(GameConfig::kArenaDim, GameConfig::kArenaSpawns, 1);
+    auto players = std::make_shared<std::map<int, Player>>();
+    QuietScope quiet;
+    for (int id = 1; id <= GameConfig::kMaxLobbyPlayers; ++id) {
+        auto [x, y] = arena->GetSpawn();
+        (*players)[id] = Player(x * GameConfig::kTileSize + GameConfig::kTileSize / 2.0f, y * GameConfig::kTileSize + GameConfig::kTileSize / 2.0f, id);
+    }
+    Cast cast;
+    cast.m_arena = arena;
+    cast.m_players = players;
+
+    BenchRandom random{ 7 };
+    std::vector<Vector2<float>> directions(1024);
+    for (auto& direction : directions) {
+        direction = Vector2<float>::Normalize({ random.Next() * 2 - 1, random.Next() * 2 - 1 });
+    }
+
+    results.push_back(Benchmark::Run("Cast/Raycast", [&](Benchmark::State& state) {
+        Player& sender = players->at(1);
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            GameObject* hit = cast.Raycast(sender.GetPosition(), directions[i % directions.size()], GameConfig::kRaycastRange, sender);
+            Benchmark::DoNotOptimize(hit);
+        }
+    }, kMinTime));
+}
+
+void BenchUpdateGame(std::vector<Benchmark::Result>& results, int players, size_t bullets)
+{
+    BenchGame game(players, 3);
+    std::string name = "GameState/UpdateGame/" + std::to_string(players) + "p/" + std::to_string(bullets) + "b";
+    results.push_back(Benchmark::Run(name, [&](Benchmark::State& state) {
+        QuietScope quiet;
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            state.PauseTiming();
+            game.Refill(bullets);
+            state.ResumeTiming();
+            game.State().UpdateGame(kFrameTime);
+        }
+    }, kMinTime));
+}
+
+// What one broadcast costs, every client gets its own view written into the game's buffer
+void BenchViewerSnapshots(std::vector<Benchmark::Result>& results, int players, size_t bullets)
+{
+    BenchGame game(players, 5);
+    std::string name = "GameState/WriteSnapshot/" + std::to_string(players) + "p/" + std::to_string(bullets) + "b";
+    std::vector<uint64_t> mapCursors(players + 1, 0);
+    results.push_back(Benchmark::Run(name, [&](Benchmark::State& state) {
+        QuietScope quiet;
+        size_t bytes = 0;
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            state.PauseTiming();
+            game.Refill(bullets);
+            state.ResumeTiming();
+            bool includeFar = game.State().NextSnapshotIndex() % NetworkConfig::kFarUpdateInterval == 0;
+            bytes = 0;
+            for (int id = 1; id <= players; ++id) {
+                bytes += game.State().WriteSnapshot(id, includeFar, mapCursors[id]).size();
+            }
+        }
+        state.SetCounter("bytes", static_cast<double>(bytes));
+    }, kMinTime));
+}
+
+#ifdef MONKEY_BENCH_JSON
+void BenchSnapshot(std::vector<Benchmark::Result>& results, int players, size_t bullets)
+{
+    BenchGame game(players, 5);
+    std::string name = "GameState/ToJson/" + std::to_string(players) + "p/" + std::to_string(bullets) + "b";
+    results.push_back(Benchmark::Run(name, [&](Benchmark::State& state) {
+        QuietScope quiet;
+        size_t bytes = 0;
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            state.PauseTiming();
+            game.Refill(bullets);
+            state.ResumeTiming();
+            std::string snapshot = game.State().ToJson().dump();
+            bytes = snapshot.size();
+        }
+        state.SetCounter("bytes", static_cast<double>(bytes));
+    }, kMinTime));
+}
+
+#endif
+
+// Same text the client sends every frame
+void BenchInputDecode(std::vector<Benchmark::Result>& results)
+{
+    const std::string message = R"({"deltaX":0.707107,"deltaY":-0.707107,"is_shooting":1,"is_specialAblity":0,"mouseX":812.000000,"mouseY":377.000000})";
+
+    results.push_back(Benchmark::Run("InputCodec/Decode", [&](Benchmark::State& state) {
+        InputMessage decoded;
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            bool ok = InputCodec::Decode(message, decoded);
+            Benchmark::DoNotOptimize(ok);
+            Benchmark::DoNotOptimize(decoded);
+        }
+    }, kMinTime));
+
+#ifdef MONKEY_BENCH_JSON
+    // What every input cost before
+    results.push_back(Benchmark::Run("crow/json::load/Input", [&](Benchmark::State& state) {
+        PlayerInput input;
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            auto json = crow::json::load(message);
+            input.movement = Vector2<float>(json["deltaX"].d(), json["deltaY"].d());
+            input.mousePosition = Vector2<float>(json["mouseX"].d(), json["mouseY"].d());
+            input.isShooting = json["is_shooting"].i() == 1;
+            input.isSpecialAbility = json["is_specialAblity"].i() == 1;
+            Benchmark::DoNotOptimize(input);
+        }
+    }, kMinTime));
+#endif
+}
+
+#ifdef MONKEY_BENCH_USERS
+void BenchUserDatabase(std::vector<Benchmark::Result>& results)
+{
+    const std::string path = "bench_users.db";
+    std::filesystem::remove(path);
+    QuietScope quiet;
+    UserDatabase database(path);
+
+    const std::string password = "Password123";
+    int nextUser = 0;
+    results.push_back(Benchmark::Run("UserDatabase/AddUser", [&](Benchmark::State& state) {
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            database.AddUser(User("bench_user_" + std::to_string(nextUser++), password, 0, 0));
+        }
+    }, kMinTime));
+
+    results.push_back(Benchmark::Run("UserDatabase/AuthenticateUser", [&](Benchmark::State& state) {
+        for (uint64_t i = 0; i < state.Iterations(); ++i) {
+            bool authenticated = database.AuthenticateUser("bench_user_" + std::to_string(i % nextUser), password);
+            Benchmark::DoNotOptimize(authenticated);
+        }
+    }, kMinTime));
+}
+#endif
+
+}
+
+// Usage: MonkeyBench [group], group is one of Arena, Raycast, UpdateGame, Snapshot, ToJson, Input, UserDatabase (default: all)
+int main(int argc, char* argv[])
+{
+    std::string filter = argc > 1 ? argv[1] : "";
+    auto selected = [&filter](const std::string& group) { return filter.empty() || group.find(filter) != std::string::npos || filter.find(group) != std::string::npos; };
+
+    // The user database bench writes bench_users.db, keep it out of the source tree
+    auto workDir = std::filesystem::temp_directory_path() / "monkey_bench";
+    std::filesystem::create_directories(workDir);
+    std::filesystem::current_path(workDir);
+
+    std::vector<Benchmark::Result> results;
+    Benchmark::PrintHeader();
+    auto flush = [&results]() {
+        for (const auto& result : results) {
+            Benchmark::Print(result);
+        }
+        results.clear();
+    };
+
+    if (selected("Arena")) {
+        for (int dim : { 50, 200, 500 }) {
+            BenchArenaGeneration(results, dim);
+            flush();
+        }
+    }
+    if (selected("Raycast")) {
+        BenchRaycast(results);
+        flush();
+    }
+    if (selected("UpdateGame")) {
+        for (int players : { 2, 4, 8 }) {
+            for (size_t bullets : { size_t{ 0 }, size_t{ 100 }, size_t{ 400 } }) {
+                BenchUpdateGame(results, players, bullets);
+                flush();
+            }
+        }
+    }
+    if (selected("Snapshot")) {
+        for (int players : { 2, 4, 8 }) {
+            for (size_t bullets : { size_t{ 0 }, size_t{ 100 }, size_t{ 400 } }) {
+                BenchViewerSnapshots(results, players, bullets);
+                flush();
+            }
+        }
+    }
+#ifdef MONKEY_BENCH_JSON
+    if (selected("ToJson")) {
+        for (int players : { 2, 4, 8 }) {
+            for (size_t bullets : { size_t{ 0 }, size_t{ 100 }, size_t{ 400 } }) {
+                BenchSnapshot(results, players, bullets);
+                flush();
+            }
+        }
+    }
+#endif
+    if (selected("Input")) {
+        BenchInputDecode(results);
+        flush();
+    }
+#ifdef MONKEY_BENCH_USERS
+    if (selected("UserDatabase")) {
+        BenchUserDatabase(results);
+        flush();
+    }
+#endif
+    return 0;
+}
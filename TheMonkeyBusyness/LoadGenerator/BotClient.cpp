@@ -0,0 +1,275 @@
+#include "BotClient.h"
+#include <chrono>
+#include <cmath>
+#include <cpr/cpr.h>
+#include <crow/json.h>
+
+namespace {
+
+int64_t NowMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string ToWebSocketUrl(const std::string& serverUrl)
+{
+    if (serverUrl.rfind("https://", 0) == 0) {
+        return "wss://" + serverUrl.substr(8) + "/webSocket";
+    }
+    if (serverUrl.rfind("http://", 0) == 0) {
+        return "ws://" + serverUrl.substr(7) + "/webSocket";
+    }
+    return serverUrl + "/webSocket";
+}
+
+constexpr int kScreenWidth = 800;
+constexpr int kScreenHeight = 600;
+
+}
+
+BotClient::BotClient(const std::string& serverUrl, const std::string& username, uint64_t seed)
+    : m_serverUrl{ serverUrl }, m_username{ username }, m_password{ "BotPass_" + std::to_string(seed % 100000) }, m_random{ seed * 2654435761u + 1 }
+{
+}
+
+BotClient::~BotClient()
+{
+    Disconnect();
+}
+
+bool BotClient::PostJson(const std::string& route, const std::string& body, std::string& response)
+{
+    cpr::Response result = cpr::Post(
+        cpr::Url{ m_serverUrl + route },
+        cpr::Header{ {"Content-Type", "application/json"} },
+        cpr::Body{ body }
+    );
+    response = result.text;
+    if (result.status_code != 200) {
+        m_lastError = route + " -> " + std::to_string(result.status_code) + " " + result.text;
+        return false;
+    }
+    return true;
+}
+
+bool BotClient::LogIn()
+{
+    std::string credentials = R"({"username":")" + m_username + R"(","password":")" + m_password + R"("})";
+    std::string response;
+    // 409 just means a previous run already created the account
+    PostJson("/signin", credentials, response);
+
+    if (!PostJson("/login", credentials, response)) {
+        return false;
+    }
+    auto json = crow::json::load(response);
+    if (!json || !json.has("playerId")) {
+        m_lastError = "/login returned no playerId";
+        return false;
+    }
+    m_playerId = static_cast<int>(json["playerId"].i());
+    return true;
+}
+
+bool BotClient::CreateLobby()
+{
+    std::string response;
+    if (!PostJson("/create_lobby", R"({"hostId":)" + std::to_string(m_playerId) + "}", response)) {
+        return false;
+    }
+    auto json = crow::json::load(response);
+    if (!json || !json.has("lobbyId")) {
+        m_lastError = "/create_lobby returned no lobbyId";
+        return false;
+    }
+    m_lobbyId = static_cast<int>(json["lobbyId"].i());
+    return true;
+}
+
+bool BotClient::JoinLobby(int lobbyId)
+{
+    std::string response;
+    if (!PostJson("/join_lobby", R"({"lobbyId":)" + std::to_string(lobbyId) + R"(,"playerId":)" + std::to_string(m_playerId) + "}", response)) {
+        return false;
+    }
+    m_lobbyId = lobbyId;
+    return true;
+}
+
+bool BotClient::SetReady()
+{
+    std::string response;
+    return PostJson("/set_ready", R"({"lobbyId":)" + std::to_string(m_lobbyId) + R"(,"playerId":)" + std::to_string(m_playerId) + R"(,"isReady":true})", response);
+}
+
+bool BotClient::StartGame()
+{
+    std::string response;
+    if (!PostJson("/start_game", R"({"lobbyId":)" + std::to_string(m_lobbyId) + R"(,"playerId":)" + std::to_string(m_playerId) + "}", response)) {
+        return false;
+    }
+    auto json = crow::json::load(response);
+    if (!json || !json.has("gameId")) {
+        m_lastError = "/start_game returned no gameId";
+        return false;
+    }
+    m_gameId = static_cast<int>(json["gameId"].i());
+    return true;
+}
+
+void BotClient::SetGameId(int gameId)
+{
+    m_gameId = gameId;
+}
+
+void BotClient::Connect()
+{
+    m_webSocket = std::make_unique<ix::WebSocket>();
+    m_webSocket->setUrl(ToWebSocketUrl(m_serverUrl));
+    m_webSocket->disableAutomaticReconnection();
+    m_webSocket->setOnMessageCallback([this](const ix::WebSocketMessagePtr& message) { OnMessage(message); });
+    m_webSocket->start();
+}
+
+bool BotClient::IsConnected() const
+{
+    return m_connected;
+}
+
+void BotClient::OnMessage(const ix::WebSocketMessagePtr& message)
+{
+    switch (message->type) {
+    case ix::WebSocketMessageType::Open:
+        // Bind the connection before the driver starts sending input on it
+        m_webSocket->send(R"({"type":"join","playerId":)" + std::to_string(m_playerId) +
+            R"(,"gameId":)" + std::to_string(m_gameId) +
+            R"(,"width":)" + std::to_string(kScreenWidth) +
+            R"(,"height":)" + std::to_string(kScreenHeight) + "}");
+        m_connected = true;
+        break;
+    case ix::WebSocketMessageType::Close:
+        m_connected = false;
+        break;
+    case ix::WebSocketMessageType::Error:
+        m_connected = false;
+        m_errors.fetch_add(1, std::memory_order_relaxed);
+        break;
+    case ix::WebSocketMessageType::Message: {
+        int64_t now = NowMicros();
+        ++m_received;
+        m_receivedBytes += message->str.size();
+        if (message->str == "0") {
+            // Server answers "0" when it no longer knows the game
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (int64_t sent = m_pendingSendMicros.exchange(0); sent != 0) {
+            m_latency.Record(now - sent);
+        }
+        if (m_lastSnapshotMicros != 0) {
+            m_snapshotInterval.Record(now - m_lastSnapshotMicros);
+        }
+        m_lastSnapshotMicros = now;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+float BotClient::NextRandom()
+{
+    // xorshift64*, plenty for scripting input
+    m_random ^= m_random >> 12;
+    m_random ^= m_random << 25;
+    m_random ^= m_random >> 27;
+    return static_cast<float>((m_random * 2685821657736338717ull) >> 40) / static_cast<float>(1 << 24);
+}
+
+void BotClient::SendInput(double timeSeconds)
+{
+    if (!m_connected) {
+        return;
+    }
+
+    // Walk in a circle that changes direction every couple of seconds, shoot now and then
+    float angle = static_cast<float>(timeSeconds * 0.5) + static_cast<float>(m_playerId);
+    float deltaX = std::cos(angle);
+    float deltaY = std::sin(angle);
+    int isShooting = NextRandom() < 0.2f ? 1 : 0;
+    int isSpecialAbility = NextRandom() < 0.005f ? 1 : 0;
+    float mouseX = NextRandom() * kScreenWidth;
+    float mouseY = NextRandom() * kScreenHeight;
+
+    std::string payload = R"({"deltaX":)" + std::to_string(deltaX) +
+        R"(,"deltaY":)" + std::to_string(deltaY) +
+        R"(,"is_shooting":)" + std::to_string(isShooting) +
+        R"(,"is_specialAblity":)" + std::to_string(isSpecialAbility) +
+        R"(,"mouseX":)" + std::to_string(mouseX) +
+        R"(,"mouseY":)" + std::to_string(mouseY) +
+        R"(,"received":)" + std::to_string(m_received.load()) + "}";
+
+    // Keep the oldest unanswered send so a slow server shows up as latency, not as lost samples
+    int64_t expected = 0;
+    m_pendingSendMicros.compare_exchange_strong(expected, NowMicros());
+    m_webSocket->send(payload);
+    m_sent.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BotClient::Disconnect()
+{
+    if (m_webSocket) {
+        m_webSocket->stop();
+        m_webSocket.reset();
+        m_connected = false;
+    }
+}
+
+int BotClient::GetPlayerId() const
+{
+    return m_playerId;
+}
+
+int BotClient::GetLobbyId() const
+{
+    return m_lobbyId;
+}
+
+int BotClient::GetGameId() const
+{
+    return m_gameId;
+}
+
+const std::string& BotClient::GetLastError() const
+{
+    return m_lastError;
+}
+
+const LatencyRecorder& BotClient::GetLatency() const
+{
+    return m_latency;
+}
+
+const LatencyRecorder& BotClient::GetSnapshotInterval() const
+{
+    return m_snapshotInterval;
+}
+
+uint64_t BotClient::GetSentCount() const
+{
+    return m_sent;
+}
+
+uint64_t BotClient::GetReceivedCount() const
+{
+    return m_received;
+}
+
+uint64_t BotClient::GetReceivedBytes() const
+{
+    return m_receivedBytes;
+}
+
+uint64_t BotClient::GetErrorCount() const
+{
+    return m_errors;
+}
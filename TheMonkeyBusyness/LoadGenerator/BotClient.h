@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <ixwebsocket/IXWebSocket.h>
+#include "LatencyRecorder.h"
+
+// One scripted player: signs up/logs in over HTTP like the Qt client does, then plays a game
+// through /webSocket. Input goes out from the shared driver thread, snapshots arrive on the
+// socket's own thread.
+class BotClient
+{
+public:
+    BotClient(const std::string& serverUrl, const std::string& username, uint64_t seed);
+    ~BotClient();
+    BotClient(const BotClient&) = delete;
+    BotClient& operator=(const BotClient&) = delete;
+
+    // HTTP setup, each returns false and keeps the reason in GetLastError() on failure
+    bool LogIn();                       // /signin when the account is new, then /login
+    bool CreateLobby();
+    bool JoinLobby(int lobbyId);
+    bool SetReady();
+    bool StartGame();                   // Host only, fills in the game id
+    void SetGameId(int gameId);
+
+    void Connect();
+    bool IsConnected() const;
+    void SendInput(double timeSeconds); // One input message, same schema as GameWindow::SendInputToServer
+    void Disconnect();
+
+    int GetPlayerId() const;
+    int GetLobbyId() const;
+    int GetGameId() const;
+    const std::string& GetLastError() const;
+
+    // Valid after Disconnect, the socket thread is gone by then
+    const LatencyRecorder& GetLatency() const;         // Input sent -> first snapshot received after it
+    const LatencyRecorder& GetSnapshotInterval() const; // Gap between consecutive snapshots
+    uint64_t GetSentCount() const;
+    uint64_t GetReceivedCount() const;
+    uint64_t GetReceivedBytes() const;
+    uint64_t GetErrorCount() const;
+
+private:
+    std::string m_serverUrl;
+    std::string m_username;
+    std::string m_password;
+    std::string m_lastError;
+    int m_playerId = -1;
+    int m_lobbyId = -1;
+    int m_gameId = -1;
+    uint64_t m_random;
+
+    std::unique_ptr<ix::WebSocket> m_webSocket;
+    std::atomic<bool> m_connected{ false };
+    std::atomic<int64_t> m_pendingSendMicros{ 0 }; // 0 when no input is waiting for its snapshot
+    int64_t m_lastSnapshotMicros = 0;
+
+    LatencyRecorder m_latency;
+    LatencyRecorder m_snapshotInterval;
+    std::atomic<uint64_t> m_sent{ 0 };
+    std::atomic<uint64_t> m_received{ 0 }; // Also reported back with every input, the server paces sends by it
+    uint64_t m_receivedBytes = 0;
+    std::atomic<uint64_t> m_errors{ 0 };
+
+    bool PostJson(const std::string& route, const std::string& body, std::string& response);
+    void OnMessage(const ix::WebSocketMessagePtr& message);
+    float NextRandom();
+};
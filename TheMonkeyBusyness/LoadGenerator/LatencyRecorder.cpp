@@ -0,0 +1,70 @@
+#include "LatencyRecorder.h"
+#include <algorithm>
+#include <cmath>
+
+void LatencyRecorder::Record(int64_t microseconds)
+{
+    m_sorted = m_samples.empty() || (m_sorted && m_samples.back() <= microseconds);
+    m_samples.push_back(microseconds);
+}
+
+void LatencyRecorder::Merge(const LatencyRecorder& other)
+{
+    m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+    m_sorted = false;
+}
+
+size_t LatencyRecorder::Count() const
+{
+    return m_samples.size();
+}
+
+int64_t LatencyRecorder::Percentile(double percent) const
+{
+    if (m_samples.empty()) {
+        return 0;
+    }
+    Sort();
+    // Nearest rank
+    size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * m_samples.size()));
+    return m_samples[std::clamp<size_t>(rank, 1, m_samples.size()) - 1];
+}
+
+int64_t LatencyRecorder::Max() const
+{
+    return m_samples.empty() ? 0 : *std::max_element(m_samples.begin(), m_samples.end());
+}
+
+double LatencyRecorder::Mean() const
+{
+    if (m_samples.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (int64_t sample : m_samples) {
+        sum += static_cast<double>(sample);
+    }
+    return sum / m_samples.size();
+}
+
+double LatencyRecorder::StandardDeviation() const
+{
+    if (m_samples.size() < 2) {
+        return 0.0;
+    }
+    double mean = Mean();
+    double sum = 0.0;
+    for (int64_t sample : m_samples) {
+        double difference = sample - mean;
+        sum += difference * difference;
+    }
+    return std::sqrt(sum / (m_samples.size() - 1));
+}
+
+void LatencyRecorder::Sort() const
+{
+    if (!m_sorted) {
+        std::sort(m_samples.begin(), m_samples.end());
+        m_sorted = true;
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Collects duration samples in microseconds and reports percentiles. Not thread safe,
+// each bot records into its own recorder and they are merged once the run is over.
+class LatencyRecorder
+{
+public:
+    void Record(int64_t microseconds);
+    void Merge(const LatencyRecorder& other);
+
+    size_t Count() const;
+    int64_t Percentile(double percent) const; // 0 when empty
+    int64_t Max() const;
+    double Mean() const;
+    double StandardDeviation() const;
+
+private:
+    mutable std::vector<int64_t> m_samples; // sorted lazily by the percentile queries
+    mutable bool m_sorted = true;
+
+    void Sort() const;
+};
@@ -0,0 +1,201 @@
+#include "BotClient.h"
+#include "LatencyRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <ixwebsocket/IXNetSystem.h>
+
+namespace {
+
+struct Options
+{
+    std::string serverUrl = "http://127.0.0.1:8080";
+    int clients = 100;
+    int playersPerGame = 4;
+    int durationSeconds = 30;
+    int inputRate = 60;
+    std::string namePrefix = "bot";
+};
+
+void PrintUsage()
+{
+    std::cout << "Usage: MonkeyLoad [--server URL] [--clients N] [--players-per-game N] [--duration SECONDS] [--rate HZ] [--prefix NAME]\n"
+        << "Logs N bots in, starts games of players-per-game bots each and drives /webSocket at the given rate.\n";
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help" || argument == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (argument == "--server") {
+            options.serverUrl = value;
+        }
+        else if (argument == "--clients") {
+            options.clients = std::atoi(value.c_str());
+        }
+        else if (argument == "--players-per-game") {
+            options.playersPerGame = std::atoi(value.c_str());
+        }
+        else if (argument == "--duration") {
+            options.durationSeconds = std::atoi(value.c_str());
+        }
+        else if (argument == "--rate") {
+            options.inputRate = std::atoi(value.c_str());
+        }
+        else if (argument == "--prefix") {
+            options.namePrefix = value;
+        }
+        else {
+            std::cerr << "Unknown option " << argument << std::endl;
+            return false;
+        }
+    }
+    return options.clients > 0 && options.playersPerGame > 0 && options.durationSeconds > 0 && options.inputRate > 0;
+}
+
+// Host creates the lobby, the others join, everyone readies up and the host starts the game
+bool StartMatch(std::vector<std::unique_ptr<BotClient>>& bots, size_t first, size_t last)
+{
+    BotClient& host = *bots[first];
+    if (!host.CreateLobby()) {
+        std::cerr << "create lobby failed: " << host.GetLastError() << std::endl;
+        return false;
+    }
+    for (size_t i = first + 1; i < last; ++i) {
+        if (!bots[i]->JoinLobby(host.GetLobbyId())) {
+            std::cerr << "join lobby failed: " << bots[i]->GetLastError() << std::endl;
+            return false;
+        }
+    }
+    for (size_t i = first; i < last; ++i) {
+        bots[i]->SetReady();
+    }
+    if (!host.StartGame()) {
+        std::cerr << "start game failed: " << host.GetLastError() << std::endl;
+        return false;
+    }
+    for (size_t i = first + 1; i < last; ++i) {
+        bots[i]->SetGameId(host.GetGameId());
+    }
+    return true;
+}
+
+void PrintRecorder(const char* name, const LatencyRecorder& recorder)
+{
+    std::printf("%-18s samples=%-9zu p50=%7.2fms p90=%7.2fms p99=%7.2fms p99.9=%7.2fms max=%7.2fms stddev=%6.2fms\n",
+        name, recorder.Count(),
+        recorder.Percentile(50) / 1000.0, recorder.Percentile(90) / 1000.0, recorder.Percentile(99) / 1000.0,
+        recorder.Percentile(99.9) / 1000.0, recorder.Max() / 1000.0, recorder.StandardDeviation() / 1000.0);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    ix::initNetSystem();
+
+    std::vector<std::unique_ptr<BotClient>> bots;
+    bots.reserve(options.clients);
+    for (int i = 0; i < options.clients; ++i) {
+        std::string username = options.namePrefix + "_" + std::to_string(i);
+        bots.push_back(std::make_unique<BotClient>(options.serverUrl, username, static_cast<uint64_t>(i) + 1));
+        if (!bots.back()->LogIn()) {
+            std::cerr << username << " login failed: " << bots.back()->GetLastError() << std::endl;
+            ix::uninitNetSystem();
+            return 1;
+        }
+    }
+    std::cout << options.clients << " bots logged in" << std::endl;
+
+    // Leftover bots that can't fill a whole game still get one of their own
+    int games = 0;
+    for (size_t first = 0; first < bots.size(); first += options.playersPerGame) {
+        size_t last = std::min(bots.size(), first + options.playersPerGame);
+        if (!StartMatch(bots, first, last)) {
+            ix::uninitNetSystem();
+            return 1;
+        }
+        ++games;
+    }
+    std::cout << games << " games started" << std::endl;
+
+    for (auto& bot : bots) {
+        bot->Connect();
+    }
+    auto connectDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    size_t connected = 0;
+    while (std::chrono::steady_clock::now() < connectDeadline) {
+        connected = 0;
+        for (const auto& bot : bots) {
+            connected += bot->IsConnected() ? 1 : 0;
+        }
+        if (connected == bots.size()) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    std::cout << connected << "/" << bots.size() << " websockets connected, running for " << options.durationSeconds << "s" << std::endl;
+
+    // One driver thread paces every bot on an absolute schedule so a slow send doesn't shift later ticks
+    const auto tick = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / options.inputRate));
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::seconds(options.durationSeconds);
+    uint64_t lateTicks = 0;
+    for (auto next = start; next < end; next += tick) {
+        std::this_thread::sleep_until(next);
+        if (std::chrono::steady_clock::now() - next > tick) {
+            ++lateTicks;
+        }
+        double seconds = std::chrono::duration<double>(next - start).count();
+        for (auto& bot : bots) {
+            bot->SendInput(seconds);
+        }
+    }
+
+    LatencyRecorder latency;
+    LatencyRecorder intervals;
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t receivedBytes = 0;
+    uint64_t errors = 0;
+    for (auto& bot : bots) {
+        bot->Disconnect();
+        latency.Merge(bot->GetLatency());
+        intervals.Merge(bot->GetSnapshotInterval());
+        sent += bot->GetSentCount();
+        received += bot->GetReceivedCount();
+        receivedBytes += bot->GetReceivedBytes();
+        errors += bot->GetErrorCount();
+    }
+    ix::uninitNetSystem();
+
+    double duration = static_cast<double>(options.durationSeconds);
+    std::printf("clients=%d games=%d rate=%dHz duration=%ds\n", options.clients, games, options.inputRate, options.durationSeconds);
+    std::printf("inputs sent=%llu (%.0f/s)  snapshots received=%llu (%.0f/s, %.1f KiB/s)  errors=%llu  late driver ticks=%llu\n",
+        static_cast<unsigned long long>(sent), sent / duration,
+        static_cast<unsigned long long>(received), received / duration, receivedBytes / duration / 1024.0,
+        static_cast<unsigned long long>(errors), static_cast<unsigned long long>(lateTicks));
+    PrintRecorder("input->snapshot", latency);
+    PrintRecorder("snapshot interval", intervals);
+    return 0;
+}
@@ -0,0 +1,212 @@
+#include "GameState.h"
+#include "ReplayReader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+struct Options
+{
+    std::string path;
+    int repeat = 1;
+    bool verbose = false;
+};
+
+struct PlaybackResult
+{
+    uint64_t ticks = 0;
+    uint64_t inputs = 0;
+    double simulatedSeconds = 0.0;
+    bool hasEnd = false;
+    uint32_t recordedTicks = 0;
+    uint64_t recordedHash = 0;
+    uint64_t hash = 0;
+    bool truncated = false;
+};
+
+// The game logs to the console on every spawn, keep that out of the timings
+class QuietScope
+{
+public:
+    explicit QuietScope(bool enabled) : m_enabled{ enabled }
+    {
+        if (m_enabled) {
+            m_out = std::cout.rdbuf(m_sink.rdbuf());
+            m_err = std::cerr.rdbuf(m_sink.rdbuf());
+        }
+    }
+    ~QuietScope()
+    {
+        if (m_enabled) {
+            std::cout.rdbuf(m_out);
+            std::cerr.rdbuf(m_err);
+        }
+    }
+
+private:
+    bool m_enabled;
+    std::ostringstream m_sink;
+    std::streambuf* m_out = nullptr;
+    std::streambuf* m_err = nullptr;
+};
+
+void PrintUsage()
+{
+    std::cout << "Usage: MonkeyReplay <replay.mbr> [--repeat N] [--verbose]\n"
+        << "Re-simulates a recorded match and checks the final state against the recording.\n";
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help" || argument == "-h") {
+            return false;
+        }
+        if (argument == "--verbose") {
+            options.verbose = true;
+        }
+        else if (argument == "--repeat") {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << argument << std::endl;
+                return false;
+            }
+            options.repeat = std::atoi(argv[++i]);
+        }
+        else if (options.path.empty() && argument.rfind("--", 0) != 0) {
+            options.path = argument;
+        }
+        else {
+            std::cerr << "Unknown option " << argument << std::endl;
+            return false;
+        }
+    }
+    return !options.path.empty() && options.repeat > 0;
+}
+
+bool Play(std::string_view data, PlaybackResult& result)
+{
+    using ReplayFormat::RecordType;
+
+    ReplayReader reader(data);
+    if (!reader.IsValid()) {
+        std::cerr << "Not a replay file or unsupported version" << std::endl;
+        return false;
+    }
+
+    std::unique_ptr<GameState> game;
+    ReplayRecord record;
+    while (reader.Next(record)) {
+        if (record.type == RecordType::Arena) {
+            game = std::make_unique<GameState>(std::make_shared<Arena>(record.arena));
+            continue;
+        }
+        if (!game) {
+            std::cerr << "Replay has records before its arena" << std::endl;
+            return false;
+        }
+
+        switch (record.type) {
+        case RecordType::Player:
+            game->AddPlayer(Player(record.position.x, record.position.y, record.playerId, record.name, record.monkeyType));
+            break;
+        case RecordType::RemovePlayer:
+            game->RemovePlayer(record.playerId);
+            break;
+        case RecordType::Resolution:
+            game->SetResolution(record.width, record.height, record.playerId);
+            break;
+        case RecordType::Input:
+            if (auto inputs = game->GetInputQueue(record.playerId)) {
+                inputs->Push(record.input); // Taken by the next tick, same as during the match
+            }
+            ++result.inputs;
+            break;
+        case RecordType::Tick:
+            game->UpdateGame(record.deltaTime);
+            ++result.ticks;
+            result.simulatedSeconds += record.deltaTime;
+            break;
+        case RecordType::End:
+            result.hasEnd = true;
+            result.recordedTicks = record.tickCount;
+            result.recordedHash = record.stateHash;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!game) {
+        std::cerr << "Replay has no arena" << std::endl;
+        return false;
+    }
+    result.truncated = reader.IsTruncated();
+    result.hash = game->StateHash();
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::ifstream file(options.path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Could not open " << options.path << std::endl;
+        return 1;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    PlaybackResult result;
+    uint64_t firstHash = 0;
+    bool stable = true;
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < options.repeat; ++run) {
+        QuietScope quiet(!options.verbose);
+        result = PlaybackResult();
+        if (!Play(data, result)) {
+            return 1;
+        }
+        if (run == 0) {
+            firstHash = result.hash;
+        }
+        stable = stable && result.hash == firstHash;
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / options.repeat;
+
+    std::printf("%s: %zu bytes, %llu ticks, %llu inputs, %.1f s of play\n", options.path.c_str(), data.size(),
+        static_cast<unsigned long long>(result.ticks), static_cast<unsigned long long>(result.inputs), result.simulatedSeconds);
+    std::printf("replayed in %.3f ms per run (%.0f ticks/s)\n", wallSeconds * 1000.0, wallSeconds > 0 ? result.ticks / wallSeconds : 0.0);
+    if (result.truncated) {
+        std::printf("replay ends in a partial record, played up to it\n");
+    }
+    if (!stable) {
+        std::printf("runs disagree on the final state, the simulation is not deterministic\n");
+        return 2;
+    }
+    if (!result.hasEnd) {
+        std::printf("no end record, the match was still running when the file was last flushed (state %016llx)\n",
+            static_cast<unsigned long long>(result.hash));
+        return 0;
+    }
+    if (result.hash != result.recordedHash || result.ticks != result.recordedTicks) {
+        std::printf("final state differs from the recording: %016llx after %llu ticks, recorded %016llx after %u\n",
+            static_cast<unsigned long long>(result.hash), static_cast<unsigned long long>(result.ticks),
+            static_cast<unsigned long long>(result.recordedHash), result.recordedTicks);
+        return 2;
+    }
+    std::printf("final state matches the recording (%016llx)\n", static_cast<unsigned long long>(result.hash));
+    return 0;
+}
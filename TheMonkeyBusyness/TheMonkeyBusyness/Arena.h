@@ -7,16 +7,20 @@
 #include "Tile.h"
 #include "TileType.h"
 #include <string>
-#include <crow.h>
+#include "JsonFwd.h"
 #include <cstdint>
 #include "ConstantValues.h"
+#include "ArenaCodec.h"
+#include "ArenaGenerator.h"
 
 
 class Arena
 {
 private:
     int m_dim;
+    uint64_t m_seed;
     std::vector<std::vector<Tile>> m_mapa;
+    std::vector<uint8_t> m_generatedTiles; // Tile types right after generation, used to diff seeded snapshots
     int m_numSpawns;
     std::vector<std::pair<int, int>> m_spawnPositions;
     struct pair_hash {
@@ -26,33 +30,27 @@ private:
         }
     };
     std::unordered_map<std::pair<int, int>, std::pair<int, int>, pair_hash> m_teleporterConnections;
-public:
 
-    Arena(int dim = 50, int numSpawn = 10);
+    ArenaSnapshot SnapshotMetadata() const; // dim, seed, spawns and teleporters without tiles
+    void Load(ArenaSnapshot snapshot);      // Builds the tiles, spawns and teleporters of a full snapshot
+public:
 
-    std::vector<std::vector<Tile>> GenerateMap(int dim, int numSpawns);
+    Arena(int dim = 50, int numSpawn = 10, uint64_t seed = ArenaGenerator::RandomSeed());
+    // Rebuilds a sent or recorded arena. Seeded snapshots are regenerated and get their changes applied,
+    // full snapshots are loaded as is, either way seeded snapshots are diffed against the generated map.
+    explicit Arena(const ArenaSnapshot& snapshot);
 
     void PrintMap() const;
 
-    void GenerateBigLiquid(std::vector<std::vector<Tile>>& mapa, int dim);
-    void GenerateSmallLiquid(std::vector<std::vector<Tile>>& mapa, int dim);
-    TileType GetRandomLiquid();
     std::pair<int, int> GetConnectedTeleporter(int x, int y) const;
-    void GenerateInitialSpawns(std::vector<std::vector<Tile>>& mapa, int dim, int numSpawns);
-    void GenerateGrass(std::vector<std::vector<Tile>>& mapa);
-    void PairTeleporters(const std::vector<std::pair<int, int>>& teleporters);
-    void PlaceTeleporters(std::vector<std::vector<Tile>>& mapa);
-    std::pair<int, int> GenerateTeleporterPosition(const std::vector<std::vector<Tile>>& mapa, int border, int offset, std::mt19937& gen);
-    void ApplyCellularAutomata(std::vector<std::vector<Tile>>& mapa, int dim, int iterations, TileType type);
-    void GenerateDestructibleWalls(std::vector<std::vector<Tile>>& mapa, int probability);
-    void TransformDestructibleWalls(std::vector<std::vector<Tile>>& mapa, int dim, int indestructibleProbability, int fakeProbability);
-    void GenerateLake(std::vector<std::vector<Tile>>& mapa, int dim, TileType type);
-    void GenerateRiver(std::vector<std::vector<Tile>>& mapa, int dim, TileType type);
-    void PlaceOppositeEdgeTeleporters(std::vector<std::vector<Tile>>& mapa, int dim, std::pair<int, int> start, std::pair<int, int> end);
 
     Tile& GetTile(int line, int col);
     std::pair<int, int> GetSpawn();
+    uint64_t GetSeed() const;
     void TriggerExplosion(int x, int y);
 
     crow::json::wvalue ToJson() const;
+    ArenaSnapshot ToSnapshot() const;
+    ArenaSnapshot ToSeededSnapshot() const; // Seed plus the tiles changed since generation
+    std::string ToBinary(bool seeded = true) const;
 };
@@ -0,0 +1,177 @@
+#include "ArenaCodec.h"
+#include <cstring>
+#include "ByteStream.h"
+
+std::string ArenaCodec::Encode(const ArenaSnapshot& snapshot)
+{
+    std::string out;
+    // Maps are mostly long runs of empty/grass/water, so a quarter of the raw size is plenty
+    out.reserve(16 + snapshot.spawns.size() * 4 + snapshot.teleporters.size() * 8 + snapshot.tiles.size() / 4);
+    ByteWriter writer(out);
+
+    out.append(kMagic, sizeof(kMagic));
+    writer.U8(kVersion);
+    writer.U8(snapshot.isSeeded ? kFlagSeeded : 0);
+    writer.U16(static_cast<uint16_t>(snapshot.dim));
+
+    writer.U16(static_cast<uint16_t>(snapshot.spawns.size()));
+    for (const auto& [x, y] : snapshot.spawns) {
+        writer.U16(static_cast<uint16_t>(x));
+        writer.U16(static_cast<uint16_t>(y));
+    }
+
+    writer.U16(static_cast<uint16_t>(snapshot.teleporters.size()));
+    for (const auto& [first, second] : snapshot.teleporters) {
+        writer.U16(static_cast<uint16_t>(first.first));
+        writer.U16(static_cast<uint16_t>(first.second));
+        writer.U16(static_cast<uint16_t>(second.first));
+        writer.U16(static_cast<uint16_t>(second.second));
+    }
+
+    writer.U64(snapshot.seed);
+
+    if (snapshot.isSeeded) {
+        writer.U32(static_cast<uint32_t>(snapshot.changes.size()));
+        for (const auto& change : snapshot.changes) {
+            writer.U16(static_cast<uint16_t>(change.x));
+            writer.U16(static_cast<uint16_t>(change.y));
+            writer.U8(change.type);
+        }
+        return out;
+    }
+
+    // Run-length encode the tiles, the run count is patched in once known
+    size_t runCountOffset = writer.Size();
+    writer.U32(0);
+    uint32_t runCount = 0;
+    const size_t tileCount = snapshot.tiles.size();
+    for (size_t i = 0; i < tileCount;) {
+        uint8_t type = snapshot.tiles[i];
+        size_t length = 1;
+        while (i + length < tileCount && length < 255 && snapshot.tiles[i + length] == type) {
+            ++length;
+        }
+        writer.U8(static_cast<uint8_t>(length));
+        writer.U8(type);
+        ++runCount;
+        i += length;
+    }
+    writer.PatchU32(runCountOffset, runCount);
+
+    return out;
+}
+
+bool ArenaCodec::Decode(std::string_view data, ArenaSnapshot& snapshot)
+{
+    if (data.size() < sizeof(kMagic) || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+
+    ByteReader reader(data.substr(sizeof(kMagic)));
+    uint8_t version, flags;
+    uint16_t dim;
+    if (!reader.U8(version) || version != kVersion || !reader.U8(flags) || !reader.U16(dim) || dim == 0) {
+        return false;
+    }
+    snapshot.dim = dim;
+
+    // Positions end up as tile indices, the data may come from a truncated or crafted file
+    auto inBounds = [dim](const std::pair<int, int>& position) { return position.first < dim && position.second < dim; };
+
+    uint16_t spawnCount;
+    if (!reader.U16(spawnCount)) return false;
+    snapshot.spawns.resize(spawnCount);
+    for (auto& spawn : snapshot.spawns) {
+        if (!reader.Position(spawn) || !inBounds(spawn)) return false;
+    }
+
+    uint16_t teleporterCount;
+    if (!reader.U16(teleporterCount)) return false;
+    snapshot.teleporters.resize(teleporterCount);
+    for (auto& [first, second] : snapshot.teleporters) {
+        if (!reader.Position(first) || !reader.Position(second) || !inBounds(first) || !inBounds(second)) return false;
+    }
+
+    if (!reader.U64(snapshot.seed)) return false;
+    snapshot.isSeeded = (flags & kFlagSeeded) != 0;
+
+    if (snapshot.isSeeded) {
+        uint32_t changeCount;
+        if (!reader.U32(changeCount)) return false;
+        snapshot.tiles.clear();
+        snapshot.changes.clear();
+        for (uint32_t i = 0; i < changeCount; ++i) {
+            uint16_t x, y;
+            uint8_t type;
+            if (!reader.U16(x) || !reader.U16(y) || !reader.U8(type) || x >= dim || y >= dim) {
+                return false;
+            }
+            snapshot.changes.push_back({ x, y, type });
+        }
+        return reader.AtEnd();
+    }
+
+    uint32_t runCount;
+    if (!reader.U32(runCount)) return false;
+    const size_t tileCount = static_cast<size_t>(dim) * dim;
+    snapshot.tiles.assign(tileCount, 0);
+    size_t filled = 0;
+    for (uint32_t run = 0; run < runCount; ++run) {
+        uint8_t length, type;
+        if (!reader.U8(length) || !reader.U8(type) || filled + length > tileCount) {
+            return false;
+        }
+        std::memset(snapshot.tiles.data() + filled, type, length);
+        filled += length;
+    }
+
+    return filled == tileCount && reader.AtEnd();
+}
+
+std::string ArenaCodec::EncodeDelta(const ArenaDelta& delta)
+{
+    std::string out;
+    out.reserve(sizeof(kDeltaMagic) + 21 + delta.changes.size() * 5);
+    ByteWriter writer(out);
+
+    out.append(kDeltaMagic, sizeof(kDeltaMagic));
+    writer.U8(kVersion);
+    writer.U64(delta.since);
+    writer.U64(delta.version);
+    writer.U32(static_cast<uint32_t>(delta.changes.size()));
+    for (const auto& change : delta.changes) {
+        writer.U16(static_cast<uint16_t>(change.x));
+        writer.U16(static_cast<uint16_t>(change.y));
+        writer.U8(change.type);
+    }
+    return out;
+}
+
+bool ArenaCodec::DecodeDelta(std::string_view data, ArenaDelta& delta)
+{
+    if (!IsDelta(data)) {
+        return false;
+    }
+
+    ByteReader reader(data.substr(sizeof(kDeltaMagic)));
+    uint8_t version;
+    uint32_t changeCount;
+    if (!reader.U8(version) || version != kVersion || !reader.U64(delta.since) || !reader.U64(delta.version) || !reader.U32(changeCount)) {
+        return false;
+    }
+    delta.changes.clear();
+    for (uint32_t i = 0; i < changeCount; ++i) {
+        uint16_t x, y;
+        uint8_t type;
+        if (!reader.U16(x) || !reader.U16(y) || !reader.U8(type)) {
+            return false;
+        }
+        delta.changes.push_back({ x, y, type });
+    }
+    return reader.AtEnd();
+}
+
+bool ArenaCodec::IsDelta(std::string_view data)
+{
+    return data.size() >= sizeof(kDeltaMagic) && std::memcmp(data.data(), kDeltaMagic, sizeof(kDeltaMagic)) == 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Binary arena format served by /game_arena and shared with the client.
+// Kept free of crow and of TileType.h so both projects can compile it.
+//
+// Layout (all integers little endian):
+//   magic 'M','B','A','R' | version u8 | flags u8 | dim u16
+//   spawnCount u16       | spawnCount * (x u16, y u16)
+//   teleporterCount u16  | teleporterCount * (x1 u16, y1 u16, x2 u16, y2 u16)
+//   seed u64
+//   then, depending on flags:
+//     full:   runCount u32    | runCount * (length u8, tileType u8)      -- row-major tiles
+//     seeded: changeCount u32 | changeCount * (x u16, y u16, tileType u8) -- tiles differing from the generated map
+//
+// Delta served by /game_arena_delta, the tiles changed between two arena versions:
+//   magic 'M','B','A','D' | version u8 | since u64 | arenaVersion u64
+//   changeCount u32       | changeCount * (x u16, y u16, tileType u8)  -- each tile once, with its latest type
+
+struct TileChange {
+    int x;
+    int y;
+    uint8_t type;
+};
+
+struct ArenaSnapshot {
+    int dim = 0;
+    uint64_t seed = 0;
+    bool isSeeded = false; // tiles left empty, regenerate them from the seed and apply changes
+    std::vector<uint8_t> tiles; // dim * dim tile types, row-major
+    std::vector<TileChange> changes;
+    std::vector<std::pair<int, int>> spawns;
+    std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> teleporters; // one entry per connected pair
+
+    uint8_t GetTile(int line, int col) const { return tiles[line * dim + col]; }
+};
+
+struct ArenaDelta {
+    uint64_t since = 0;   // Arena version the changes apply on top of
+    uint64_t version = 0; // Arena version after applying them
+    std::vector<TileChange> changes;
+};
+
+namespace ArenaCodec {
+    constexpr char kMagic[4] = { 'M', 'B', 'A', 'R' };
+    constexpr char kDeltaMagic[4] = { 'M', 'B', 'A', 'D' };
+    constexpr uint8_t kVersion = 2;
+    constexpr uint8_t kFlagSeeded = 0x01;
+    constexpr const char* kContentType = "application/octet-stream";
+
+    std::string Encode(const ArenaSnapshot& snapshot);
+    bool Decode(std::string_view data, ArenaSnapshot& snapshot); // false on malformed or unsupported input
+
+    std::string EncodeDelta(const ArenaDelta& delta);
+    bool DecodeDelta(std::string_view data, ArenaDelta& delta); // false on malformed input, or a full arena
+    bool IsDelta(std::string_view data);                        // Tells the two answers of /game_arena_delta apart
+}
@@ -0,0 +1,494 @@
+#include "ArenaGenerator.h"
+#include "NoiseGrid.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARENA_GENERATOR_SSE2
+#endif
+
+namespace {
+    // Work per parallel chunk, small arenas stay on the calling thread
+    constexpr int kNoiseCellsPerChunk = 4096;
+    constexpr int kAutomataCellsPerChunk = 16384;
+}
+
+ArenaGenerator::ArenaGenerator(uint64_t seed) : m_rng{ seed }, m_seed{ seed }
+{
+}
+
+uint64_t ArenaGenerator::RandomSeed()
+{
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+void ArenaGenerator::Materialize(ArenaSnapshot& snapshot)
+{
+    if (!snapshot.isSeeded) {
+        return;
+    }
+
+    ArenaGenerator generator(snapshot.seed);
+    snapshot.tiles = generator.Generate(snapshot.dim, static_cast<int>(snapshot.spawns.size())).tiles;
+    for (const auto& change : snapshot.changes) {
+        snapshot.tiles[change.y * snapshot.dim + change.x] = change.type;
+    }
+    snapshot.changes.clear();
+    snapshot.isSeeded = false;
+}
+
+ArenaSnapshot ArenaGenerator::Generate(int dim, int numSpawns)
+{
+    // Every call starts from the seed so the same generator always yields the same map
+    m_rng = ArenaRandom(m_seed);
+    m_dim = dim;
+    m_tiles.assign(static_cast<size_t>(dim) * dim, TileType::Empty);
+    m_spawns.clear();
+    m_teleporters.clear();
+
+    // Create indestructible walls around the edges
+    for (int i = 0; i < dim; i++) {
+        At(0, i) = TileType::IndestructibleWall;
+        At(dim - 1, i) = TileType::IndestructibleWall;
+        At(i, 0) = TileType::IndestructibleWall;
+        At(i, dim - 1) = TileType::IndestructibleWall;
+    }
+
+    // Generate liquids
+    GenerateBigLiquid();
+    GenerateSmallLiquid();
+
+    // Generate destructible walls
+    GenerateDestructibleWalls(35); // 35% chance for initial destructible walls
+
+    // Transform destructible walls into other types
+    TransformDestructibleWalls(10, 20); // 10% chance for indestructible, 20% for fake destructible
+
+    // Add grass
+    GenerateGrass();
+
+    // Generate spawns and teleporters
+    GenerateInitialSpawns(numSpawns, 8);
+    PlaceTeleporters();
+
+    ArenaSnapshot snapshot;
+    snapshot.dim = dim;
+    snapshot.seed = m_seed;
+    snapshot.tiles.resize(m_tiles.size());
+    std::transform(m_tiles.begin(), m_tiles.end(), snapshot.tiles.begin(),
+        [](TileType type) { return static_cast<uint8_t>(type); });
+    snapshot.spawns = m_spawns;
+    snapshot.teleporters = m_teleporters;
+    return snapshot;
+}
+
+TileType ArenaGenerator::GetRandomLiquid()
+{
+    return (m_rng.Range(0, 1) == 0) ? TileType::Water : TileType::Lava;
+}
+
+void ArenaGenerator::GenerateBigLiquid()
+{
+    TileType type = GetRandomLiquid();
+    bool isRiver = m_rng.Range(0, 1) == 0;
+
+    if (isRiver) {
+        GenerateRiver(type);
+    }
+    else {
+        GenerateLake();
+    }
+}
+
+void ArenaGenerator::GenerateLake()
+{
+    // Frequency controls the level of detail in the noise pattern
+    NoiseGrid noise(static_cast<int>(static_cast<uint32_t>(m_rng.Next())), 0.1f);
+
+    TileType liquidType = GetRandomLiquid();
+
+    // Randomly choose the center point for the lake
+    int centerX = m_dim / 5 + m_rng.Range(0, m_dim / 2 - 1);
+    int centerY = m_dim / 5 + m_rng.Range(0, m_dim / 2 - 1);
+
+    int maxRadius = m_dim / 7 + m_rng.Range(0, m_dim / 8 - 1);
+
+    // Rows only read the noise and write their own tiles, so they can be filled in parallel
+    WorkerPool::Shared().ParallelFor(0, m_dim, std::max(1, kNoiseCellsPerChunk / m_dim), [&](int firstRow, int lastRow) {
+        std::vector<float> rowNoise(m_dim);
+        for (int y = firstRow; y < lastRow; ++y) {
+            noise.Fill(0, y, m_dim, 1, rowNoise.data());
+            for (int x = 0; x < m_dim; ++x) {
+                // Calculate distance from the center
+                int dx = x - centerX;
+                int dy = y - centerY;
+                float distance = std::sqrt(static_cast<float>(dx * dx + dy * dy));
+
+                // Add Perlin noise to the distance calculation
+                float noiseValue = rowNoise[x];
+
+                // Base condition for being part of the lake
+                bool isLake = distance + noiseValue * maxRadius / 4.0f <= maxRadius;
+
+                // Add fragmentation if it's lava and near the edge of the lake
+                float edgeDistance = maxRadius - distance;
+                bool isFragment = liquidType == TileType::Lava && edgeDistance >= 0 && edgeDistance < 3.0f && noiseValue > 0.6f;
+
+                // Ensure we don't overwrite existing important tiles
+                if ((isLake || isFragment) && At(x, y) == TileType::Empty) {
+                    At(x, y) = liquidType;
+                }
+            }
+        }
+    });
+}
+
+void ArenaGenerator::GenerateRiver(TileType type)
+{
+    int startX = 0, startY = 0, endX = 0, endY = 0;
+    int edge = m_rng.Range(0, 3);
+
+    // Determine the start edge and set the opposite edge for the endpoint
+    switch (edge) {
+    case 0: // Top to Bottom
+        startX = m_rng.Range(1, m_dim - 2);
+        startY = 1;
+        endX = m_rng.Range(1, m_dim - 2);
+        endY = m_dim - 2;
+        break;
+
+    case 1: // Bottom to Top
+        startX = m_rng.Range(1, m_dim - 2);
+        startY = m_dim - 2;
+        endX = m_rng.Range(1, m_dim - 2);
+        endY = 1;
+        break;
+
+    case 2: // Left to Right
+        startX = 1;
+        startY = m_rng.Range(1, m_dim - 2);
+        endX = m_dim - 2;
+        endY = m_rng.Range(1, m_dim - 2);
+        break;
+
+    case 3: // Right to Left
+        startX = m_dim - 2;
+        startY = m_rng.Range(1, m_dim - 2);
+        endX = 1;
+        endY = m_rng.Range(1, m_dim - 2);
+        break;
+    }
+
+    int x = startX, y = startY;
+    int width = m_dim / 20; // River width
+
+    int directionX = (endX > startX) ? 1 : (endX < startX) ? -1 : 0;
+    int directionY = (endY > startY) ? 1 : (endY < startY) ? -1 : 0;
+
+    // Generate the river path
+    while ((x != endX || y != endY) && x > 0 && x < m_dim - 1 && y > 0 && y < m_dim - 1) {
+        for (int dx = -width / 2; dx <= width / 2; ++dx) {
+            for (int dy = -width / 2; dy <= width / 2; ++dy) {
+                int nx = x + dx, ny = y + dy;
+                if (nx >= 1 && nx < m_dim - 1 && ny >= 1 && ny < m_dim - 1) {
+                    At(nx, ny) = type;
+                }
+            }
+        }
+
+        if (m_rng.Range(0, 99) < 20) {
+            directionX += m_rng.Range(-1, 1);
+            directionY += m_rng.Range(-1, 1);
+        }
+
+        directionX = std::clamp(directionX, -1, 1);
+        directionY = std::clamp(directionY, -1, 1);
+
+        x += directionX;
+        y += directionY;
+    }
+
+    // Place teleporters at opposite edges to ensure accessibility
+    PlaceOppositeEdgeTeleporters({ startX, startY }, { endX, endY });
+}
+
+void ArenaGenerator::PlaceOppositeEdgeTeleporters(Position start, Position end)
+{
+    // Place teleporter at the start edge
+    if (At(start.first, start.second) == TileType::Empty) {
+        At(start.first, start.second) = TileType::Teleporter;
+    }
+
+    // Place teleporter at the end edge
+    if (At(end.first, end.second) == TileType::Empty) {
+        At(end.first, end.second) = TileType::Teleporter;
+    }
+
+    // Pair the teleporters
+    m_teleporters.emplace_back(start, end);
+}
+
+void ArenaGenerator::GenerateSmallLiquid()
+{
+    TileType type = GetRandomLiquid();
+    if (type == TileType::Water)
+        type = TileType::Lava;
+    else
+        type = TileType::Water;
+
+    // Determinam locatia spre margine
+    int startX = (m_rng.Range(0, 1) == 0) ? m_rng.Range(0, m_dim / 4 - 1) : (m_dim - 1 - m_rng.Range(0, m_dim / 4 - 1));
+    int startY = (m_rng.Range(0, 1) == 0) ? m_rng.Range(0, m_dim / 4 - 1) : (m_dim - 1 - m_rng.Range(0, m_dim / 4 - 1));
+
+    int lakeRadius = m_rng.Range(1, m_dim / 10); // raza mica pentru lac
+
+    for (int dy = -lakeRadius; dy <= lakeRadius; ++dy) {
+        for (int dx = -lakeRadius; dx <= lakeRadius; ++dx) {
+            int x = startX + dx;
+            int y = startY + dy;
+            if (x >= 1 && x < m_dim - 1 && y >= 1 && y < m_dim - 1) {
+                if (dx * dx + dy * dy <= lakeRadius * lakeRadius) {
+                    At(x, y) = type;
+                }
+            }
+        }
+    }
+}
+
+void ArenaGenerator::GenerateDestructibleWalls(int probability)
+{
+    for (int y = 1; y < m_dim - 1; ++y) {
+        for (int x = 1; x < m_dim - 1; ++x) {
+            if (m_rng.Range(0, 100) < probability && At(x, y) == TileType::Empty) {
+                At(x, y) = TileType::DestructibleWall;
+            }
+        }
+    }
+    ApplyCellularAutomata(3, TileType::DestructibleWall);
+}
+
+void ArenaGenerator::TransformDestructibleWalls(int indestructibleProbability, int fakeProbability)
+{
+    for (int y = 1; y < m_dim - 1; ++y) {
+        for (int x = 1; x < m_dim - 1; ++x) {
+            if (At(x, y) == TileType::DestructibleWall) {
+                int randomValue = m_rng.Range(0, 100);
+                if (randomValue < indestructibleProbability) {
+                    At(x, y) = TileType::IndestructibleWall;
+                }
+                else if (randomValue < indestructibleProbability + fakeProbability) {
+                    At(x, y) = TileType::FakeDestructibleWall;
+                }
+            }
+        }
+    }
+}
+
+void ArenaGenerator::GenerateGrass()
+{
+    for (int y = 1; y < m_dim - 1; ++y) {
+        for (int x = 1; x < m_dim - 1; ++x) {
+            if (m_rng.Range(0, 100) < 35 && At(x, y) == TileType::Empty) { // 35% chance for initial grass
+                At(x, y) = TileType::Grass;
+            }
+        }
+    }
+
+    // Use the generic cellular automata function for grass refinement
+    ApplyCellularAutomata(3, TileType::Grass);
+}
+
+void ArenaGenerator::ApplyCellularAutomata(int iterations, TileType type)
+{
+    // Double buffered: only interior Empty/type tiles ever change, so after one full copy
+    // every step rewrites the interior of the back buffer and the buffers are swapped
+    m_backTiles = m_tiles;
+
+    for (int it = 0; it < iterations; ++it) {
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(m_tiles.data());
+        uint8_t* dst = reinterpret_cast<uint8_t*>(m_backTiles.data());
+
+        WorkerPool::Shared().ParallelFor(1, m_dim - 1, std::max(1, kAutomataCellsPerChunk / m_dim), [&](int firstRow, int lastRow) {
+            for (int y = firstRow; y < lastRow; ++y) {
+                StepCellularAutomataRow(src, dst, m_dim, y, static_cast<uint8_t>(type));
+            }
+        });
+
+        m_tiles.swap(m_backTiles); // Update the map after each iteration
+    }
+}
+
+void ArenaGenerator::StepCellularAutomataRow(const uint8_t* src, uint8_t* dst, int dim, int y, uint8_t type)
+{
+    static_assert(static_cast<uint8_t>(TileType::Empty) == 0, "the SIMD step relies on Empty being zero");
+    constexpr uint8_t empty = static_cast<uint8_t>(TileType::Empty);
+
+    const uint8_t* above = src + (y - 1) * dim;
+    const uint8_t* row = src + y * dim;
+    const uint8_t* below = src + (y + 1) * dim;
+    uint8_t* out = dst + y * dim;
+
+    int x = 1;
+#ifdef ARENA_GENERATOR_SSE2
+    // 16 tiles per step: every neighbour equal to type adds one (compare gives -1, so subtract it)
+    const __m128i typeVec = _mm_set1_epi8(static_cast<char>(type));
+    const __m128i three = _mm_set1_epi8(3);
+    for (; x + 16 <= dim - 1; x += 16) {
+        __m128i count = _mm_setzero_si128();
+        for (const uint8_t* line : { above, row, below }) {
+            count = _mm_sub_epi8(count, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(line + x - 1)), typeVec));
+            count = _mm_sub_epi8(count, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(line + x + 1)), typeVec));
+        }
+        count = _mm_sub_epi8(count, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(above + x)), typeVec));
+        count = _mm_sub_epi8(count, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(below + x)), typeVec));
+
+        __m128i center = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        __m128i editable = _mm_or_si128(_mm_cmpeq_epi8(center, typeVec), _mm_cmpeq_epi8(center, _mm_setzero_si128()));
+        __m128i grown = _mm_and_si128(_mm_cmpgt_epi8(count, three), typeVec); // type when count >= 4, Empty otherwise
+        __m128i result = _mm_or_si128(_mm_and_si128(editable, grown), _mm_andnot_si128(editable, center));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), result);
+    }
+#endif
+
+    for (; x < dim - 1; ++x) {
+        uint8_t center = row[x];
+        // Skip tiles that are not the specified type or empty
+        if (center != empty && center != type) {
+            out[x] = center;
+            continue;
+        }
+
+        // Count neighboring tiles
+        int count = (above[x - 1] == type) + (above[x] == type) + (above[x + 1] == type)
+            + (row[x - 1] == type) + (row[x + 1] == type)
+            + (below[x - 1] == type) + (below[x] == type) + (below[x + 1] == type);
+
+        // Apply Cellular Automata rules
+        out[x] = (count >= 4) ? type : empty;
+    }
+}
+
+// Function to place spawns with a significant distance between them
+void ArenaGenerator::GenerateInitialSpawns(int numSpawns, int minDistance)
+{
+    for (int i = 0; i < numSpawns; ++i) {
+        int x, y;
+        bool validSpawn;
+
+        do {
+            x = m_rng.Range(1, m_dim - 2); // Avoid borders
+            y = m_rng.Range(1, m_dim - 2);
+
+            validSpawn = true;
+
+            // Check if the selected tile is empty
+            if (At(x, y) != TileType::Empty) {
+                validSpawn = false;
+                continue;
+            }
+
+            // Check if the spawn is sufficiently far from existing spawns
+            for (const auto& [sx, sy] : m_spawns) {
+                int dx = x - sx;
+                int dy = y - sy;
+                if (dx * dx + dy * dy < minDistance * minDistance) {
+                    validSpawn = false;
+                    break;
+                }
+            }
+
+            // Check if the 3x3 area around the tile is clear
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int nx = x + dx;
+                    int ny = y + dy;
+
+                    if (nx >= 0 && nx < m_dim && ny >= 0 && ny < m_dim) {
+                        if (At(nx, ny) != TileType::Empty) {
+                            validSpawn = false;
+                            break;
+                        }
+                    }
+                }
+                if (!validSpawn) break;
+            }
+
+        } while (!validSpawn);
+
+        // Place the spawn
+        At(x, y) = TileType::Spawn;
+        m_spawns.emplace_back(x, y);
+    }
+}
+
+void ArenaGenerator::PlaceTeleporters()
+{
+    int numTeleporters = m_rng.Range(0, 2) * 2; // Ensure an even number (0, 2, or 4)
+    if (numTeleporters == 0) return;
+
+    // Borders: 0 = top, 1 = bottom, 2 = left, 3 = right
+    std::vector<int> borders = { 0, 1, 2, 3 };
+    m_rng.Shuffle(borders); // Randomize borders
+
+    for (int i = 0; i < numTeleporters / 2; ++i) {
+        if (borders.size() < 2) break; // Ensure enough distinct borders
+
+        // Pick two distinct borders
+        int border1 = borders.back();
+        borders.pop_back();
+        int border2 = borders.back();
+        borders.pop_back();
+
+        // Place teleporter on the first border, 1 to 8 tiles from the corner
+        Position teleporter1 = GenerateTeleporterPosition(border1, m_rng.Range(1, 8));
+        At(teleporter1.first, teleporter1.second) = TileType::Teleporter;
+
+        // Place teleporter on the second border
+        Position teleporter2 = GenerateTeleporterPosition(border2, m_rng.Range(1, 8));
+        At(teleporter2.first, teleporter2.second) = TileType::Teleporter;
+
+        // Pair the teleporters
+        m_teleporters.emplace_back(teleporter1, teleporter2);
+    }
+}
+
+ArenaGenerator::Position ArenaGenerator::GenerateTeleporterPosition(int border, int offset)
+{
+    int x = 0, y = 0;
+
+    switch (border) {
+    case 0: // Top border
+        x = offset;
+        y = 1;
+        break;
+    case 1: // Bottom border
+        x = offset;
+        y = m_dim - 2;
+        break;
+    case 2: // Left border
+        x = 1;
+        y = offset;
+        break;
+    case 3: // Right border
+        x = m_dim - 2;
+        y = offset;
+        break;
+    }
+
+    // Ensure the chosen tile is empty
+    while (At(x, y) != TileType::Empty) {
+        offset = m_rng.Range(1, m_dim - 2); // Avoid corners
+        switch (border) {
+        case 0: y = 1; x = offset; break;      // Top border
+        case 1: y = m_dim - 2; x = offset; break; // Bottom border
+        case 2: x = 1; y = offset; break;      // Left border
+        case 3: x = m_dim - 2; y = offset; break; // Right border
+        }
+    }
+
+    return { x, y };
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "ArenaCodec.h"
+#include "TileType.h"
+
+// Small explicit PRNG (SplitMix64) so a seed yields the same map with any compiler.
+// std::uniform_int_distribution and std::shuffle are implementation defined, so they are not used here.
+class ArenaRandom
+{
+public:
+    explicit ArenaRandom(uint64_t seed) : m_state{ seed } {}
+
+    uint64_t Next()
+    {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform integer in [min, max]
+    int Range(int min, int max)
+    {
+        uint64_t span = static_cast<uint64_t>(max - min) + 1;
+        return min + static_cast<int>(Next() % span);
+    }
+
+    template <typename T>
+    void Shuffle(std::vector<T>& values)
+    {
+        for (size_t i = values.size(); i > 1; --i) {
+            std::swap(values[i - 1], values[Range(0, static_cast<int>(i) - 1)]);
+        }
+    }
+
+private:
+    uint64_t m_state;
+};
+
+// Builds an arena purely from (dim, numSpawns, seed). Server and client run the same code,
+// so the server only has to send the seed plus the tiles that changed since generation.
+class ArenaGenerator
+{
+public:
+    explicit ArenaGenerator(uint64_t seed);
+
+    ArenaSnapshot Generate(int dim, int numSpawns);
+
+    // Fills in the tiles of a seeded snapshot: regenerates the map and applies the changes on top
+    static void Materialize(ArenaSnapshot& snapshot);
+
+    static uint64_t RandomSeed(); // Non-deterministic seed for a brand new arena
+
+private:
+    using Position = std::pair<int, int>;
+
+    ArenaRandom m_rng;
+    uint64_t m_seed;
+    int m_dim = 0;
+    std::vector<TileType> m_tiles; // Row-major dim * dim grid
+    std::vector<TileType> m_backTiles; // Second buffer for the cellular automata steps
+    std::vector<Position> m_spawns;
+    std::vector<std::pair<Position, Position>> m_teleporters;
+
+    TileType& At(int x, int y) { return m_tiles[y * m_dim + x]; }
+
+    TileType GetRandomLiquid();
+    void GenerateBigLiquid();
+    void GenerateSmallLiquid();
+    void GenerateLake();
+    void GenerateRiver(TileType type);
+    void PlaceOppositeEdgeTeleporters(Position start, Position end);
+    void GenerateDestructibleWalls(int probability);
+    void TransformDestructibleWalls(int indestructibleProbability, int fakeProbability);
+    void GenerateGrass();
+    void ApplyCellularAutomata(int iterations, TileType type);
+    static void StepCellularAutomataRow(const uint8_t* src, uint8_t* dst, int dim, int y, uint8_t type);
+    void GenerateInitialSpawns(int numSpawns, int minDistance);
+    void PlaceTeleporters();
+    Position GenerateTeleporterPosition(int border, int offset);
+};
@@ -0,0 +1,66 @@
+#include "ArenaPool.h"
+#include "WorkerPool.h"
+
+ArenaPool::ArenaPool(size_t poolSize) : m_poolSize{ poolSize }
+{
+}
+
+std::shared_ptr<Arena> ArenaPool::Acquire(int dim, int numSpawns)
+{
+    Config config{ dim, numSpawns };
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Slot& slot = m_slots[config];
+        std::shared_ptr<Arena> arena;
+        if (!slot.ready.empty()) {
+            arena = std::move(slot.ready.front());
+            slot.ready.pop_front();
+        }
+        ScheduleRefills(config, slot);
+        if (arena) {
+            return arena;
+        }
+    }
+
+    // Pool ran dry (first match of this size or a burst of starts), don't make the caller wait for the queue
+    return std::make_shared<Arena>(dim, numSpawns);
+}
+
+void ArenaPool::Prewarm(int dim, int numSpawns)
+{
+    Config config{ dim, numSpawns };
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ScheduleRefills(config, m_slots[config]);
+}
+
+size_t ArenaPool::GetReadyCount(int dim, int numSpawns)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_slots.find({ dim, numSpawns });
+    return it != m_slots.end() ? it->second.ready.size() : 0;
+}
+
+void ArenaPool::ScheduleRefills(const Config& config, Slot& slot)
+{
+    // Tasks only hold a weak reference so a pool destroyed at shutdown is simply skipped
+    std::weak_ptr<ArenaPool> weakSelf = weak_from_this();
+    if (weakSelf.expired()) {
+        return; // not owned by a shared_ptr, nothing can safely outlive this call
+    }
+
+    while (slot.ready.size() + slot.pending < m_poolSize) {
+        ++slot.pending;
+        WorkerPool::Shared().Submit([weakSelf, config]() {
+            auto self = weakSelf.lock();
+            if (!self) {
+                return;
+            }
+            auto arena = std::make_shared<Arena>(config.first, config.second);
+
+            std::lock_guard<std::mutex> lock(self->m_mutex);
+            Slot& slot = self->m_slots[config];
+            --slot.pending;
+            slot.ready.push_back(std::move(arena));
+        });
+    }
+}
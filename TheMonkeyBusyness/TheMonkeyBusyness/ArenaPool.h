@@ -0,0 +1,38 @@
+#pragma once
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "Arena.h"
+#include "ConstantValues.h"
+
+// Keeps a few freshly generated arenas ready per (dim, numSpawns) so starting a match
+// only pops one off a queue. Refills run on the shared WorkerPool.
+class ArenaPool : public std::enable_shared_from_this<ArenaPool>
+{
+public:
+    explicit ArenaPool(size_t poolSize = GameConfig::kArenaPoolSize);
+
+    // O(1) when an arena is ready, otherwise generates one on the calling thread
+    std::shared_ptr<Arena> Acquire(int dim = GameConfig::kArenaDim, int numSpawns = GameConfig::kArenaSpawns);
+
+    // Starts filling the pool for a config ahead of the first Acquire
+    void Prewarm(int dim = GameConfig::kArenaDim, int numSpawns = GameConfig::kArenaSpawns);
+
+    size_t GetReadyCount(int dim, int numSpawns);
+
+private:
+    using Config = std::pair<int, int>; // dim, numSpawns
+
+    struct Slot {
+        std::deque<std::shared_ptr<Arena>> ready;
+        size_t pending = 0; // refills queued on the worker pool
+    };
+
+    size_t m_poolSize;
+    std::map<Config, Slot> m_slots;
+    std::mutex m_mutex;
+
+    void ScheduleRefills(const Config& config, Slot& slot); // m_mutex must be held
+};
@@ -6,12 +6,10 @@ BasicMonkey::BasicMonkey()
 
 void BasicMonkey::ActivateSpecialAbility() 
 { //Special Ability = Quick Escape 
-    auto now = std::chrono::steady_clock::now();
     if (m_remainingCooldown <= 0) {
         std::cout << "BasicMonkey activates Speed Boost!\n";
 
         m_speed += 10;
-        m_abilityStartTime = now;
 
         std::cout << "BasicMonkey ate a banana, gains +10 speed points!\n";
         std::cout << "New Speed: " << m_speed << "\n";
@@ -20,8 +18,6 @@ void BasicMonkey::ActivateSpecialAbility()
         m_remainingCooldown = m_cooldownTime;
     }
     else {
-        std::chrono::duration<float> elapsed = now - m_abilityStartTime;
-        m_remainingCooldown = m_cooldownTime - elapsed.count();
         std::cout << "Ability is on cooldown. Time left: " << m_remainingCooldown << " seconds.\n";
     }
 }
@@ -1,8 +1,7 @@
 #pragma once
-//#include "Character.h"
 #include <chrono>
 #include <iostream>
-import CharacterModule;
+#include "Character.h"
 
 class BasicMonkey : public Character
 {
@@ -12,6 +11,5 @@ public:
 	~BasicMonkey() = default;
 private:
 	bool m_speedBoostActive;
-	std::chrono::steady_clock::time_point m_abilityStartTime;
 };
 
@@ -0,0 +1,90 @@
+#include "BulletPool.h"
+#include "MotionKernels.h"
+
+BulletPool::BulletPool(size_t capacity)
+	: m_owner(capacity), m_positionX(capacity), m_positionY(capacity), m_directionX(capacity), m_directionY(capacity),
+	m_speed(capacity), m_damage(capacity), m_size{ 0 }
+{
+}
+
+bool BulletPool::Spawn(int ownerId, const Vector2<float>& position, const Vector2<float>& direction, float speed, float damage)
+{
+	if (m_size == Capacity())
+		return false;
+
+	m_owner[m_size] = ownerId;
+	m_positionX[m_size] = position.x;
+	m_positionY[m_size] = position.y;
+	m_directionX[m_size] = direction.x;
+	m_directionY[m_size] = direction.y;
+	m_speed[m_size] = speed;
+	m_damage[m_size] = damage;
+	++m_size;
+	return true;
+}
+
+void BulletPool::Deactivate(size_t index)
+{
+	if (index >= m_size)
+		return;
+
+	size_t last = --m_size;
+	m_owner[index] = m_owner[last];
+	m_positionX[index] = m_positionX[last];
+	m_positionY[index] = m_positionY[last];
+	m_directionX[index] = m_directionX[last];
+	m_directionY[index] = m_directionY[last];
+	m_speed[index] = m_speed[last];
+	m_damage[index] = m_damage[last];
+}
+
+void BulletPool::Integrate(float deltaTime)
+{
+	MotionKernels::IntegrateDirections(m_positionX.data(), m_positionY.data(), m_directionX.data(), m_directionY.data(),
+		m_speed.data(), deltaTime, m_size);
+}
+
+size_t BulletPool::Size() const {
+	return m_size;
+}
+
+size_t BulletPool::Capacity() const {
+	return m_positionX.size();
+}
+
+bool BulletPool::Empty() const {
+	return m_size == 0;
+}
+
+int BulletPool::GetOwner(size_t index) const {
+	return m_owner[index];
+}
+
+Vector2<float> BulletPool::GetPosition(size_t index) const {
+	return Vector2<float>(m_positionX[index], m_positionY[index]);
+}
+
+Vector2<float> BulletPool::GetDirection(size_t index) const {
+	return Vector2<float>(m_directionX[index], m_directionY[index]);
+}
+
+float BulletPool::GetSpeed(size_t index) const {
+	return m_speed[index];
+}
+
+float BulletPool::GetDamage(size_t index) const {
+	return m_damage[index];
+}
+
+void BulletPool::WriteSnapshot(size_t index, SnapshotWriter& writer) const {
+	writer.BeginObject();
+	writer.Key("x");
+	writer.Float(m_positionX[index]);
+	writer.Key("y");
+	writer.Float(m_positionY[index]);
+	writer.Key("directionX");
+	writer.Float(m_directionX[index]);
+	writer.Key("directionY");
+	writer.Float(m_directionY[index]);
+	writer.EndObject();
+}
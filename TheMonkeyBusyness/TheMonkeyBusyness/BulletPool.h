@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include "Vector2.h"
+#include "ConstantValues.h"
+#include "JsonFwd.h"
+#include "SnapshotWriter.h"
+
+// Every bullet of a game stored as parallel arrays, tagged with the id of the player that fired it.
+// Slots [0, Size()) are live, removal swaps the last bullet into the freed slot, so bullet order
+// is not stable across Deactivate calls.
+class BulletPool
+{
+public:
+	explicit BulletPool(size_t capacity = WeaponConfig::kMaxBasicBullets * GameConfig::kMaxLobbyPlayers);
+
+	bool Spawn(int ownerId, const Vector2<float>& position, const Vector2<float>& direction, float speed, float damage); // false when full
+	void Deactivate(size_t index);
+	void Integrate(float deltaTime); // Moves every live bullet along its direction
+
+	size_t Size() const;
+	size_t Capacity() const;
+	bool Empty() const;
+
+	int GetOwner(size_t index) const;
+	Vector2<float> GetPosition(size_t index) const;
+	Vector2<float> GetDirection(size_t index) const;
+	float GetSpeed(size_t index) const;
+	float GetDamage(size_t index) const;
+
+	crow::json::wvalue ToJson(size_t index) const;
+	void WriteSnapshot(size_t index, SnapshotWriter& writer) const; // Same object as ToJson
+
+private:
+	std::vector<int> m_owner;
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_directionX;
+	std::vector<float> m_directionY;
+	std::vector<float> m_speed;
+	std::vector<float> m_damage;
+	size_t m_size;
+};
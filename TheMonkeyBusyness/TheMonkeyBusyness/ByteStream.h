@@ -0,0 +1,99 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Little endian encoding shared by the binary formats (ArenaCodec, replays).
+// Header only and free of game types so the client can compile it too.
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::string& out) : m_out{ out } {}
+
+    void U8(uint8_t value) { m_out.push_back(static_cast<char>(value)); }
+    void U16(uint16_t value) {
+        U8(static_cast<uint8_t>(value & 0xFF));
+        U8(static_cast<uint8_t>(value >> 8));
+    }
+    void U32(uint32_t value) {
+        U16(static_cast<uint16_t>(value & 0xFFFF));
+        U16(static_cast<uint16_t>(value >> 16));
+    }
+    void U64(uint64_t value) {
+        U32(static_cast<uint32_t>(value & 0xFFFFFFFF));
+        U32(static_cast<uint32_t>(value >> 32));
+    }
+    void I32(int32_t value) { U32(static_cast<uint32_t>(value)); }
+    void F32(float value) { U32(std::bit_cast<uint32_t>(value)); } // Bit exact, replays depend on it
+    void Bytes(std::string_view bytes) { m_out.append(bytes); }
+    void PatchU32(size_t offset, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            m_out[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+    size_t Size() const { return m_out.size(); }
+
+private:
+    std::string& m_out;
+};
+
+class ByteReader {
+public:
+    explicit ByteReader(std::string_view data) : m_data{ data } {}
+
+    bool U8(uint8_t& value) {
+        if (m_offset + 1 > m_data.size()) return false;
+        value = static_cast<uint8_t>(m_data[m_offset++]);
+        return true;
+    }
+    bool U16(uint16_t& value) {
+        uint8_t low, high;
+        if (!U8(low) || !U8(high)) return false;
+        value = static_cast<uint16_t>(low | (high << 8));
+        return true;
+    }
+    bool U32(uint32_t& value) {
+        uint16_t low, high;
+        if (!U16(low) || !U16(high)) return false;
+        value = static_cast<uint32_t>(low) | (static_cast<uint32_t>(high) << 16);
+        return true;
+    }
+    bool U64(uint64_t& value) {
+        uint32_t low, high;
+        if (!U32(low) || !U32(high)) return false;
+        value = static_cast<uint64_t>(low) | (static_cast<uint64_t>(high) << 32);
+        return true;
+    }
+    bool I32(int32_t& value) {
+        uint32_t bits;
+        if (!U32(bits)) return false;
+        value = static_cast<int32_t>(bits);
+        return true;
+    }
+    bool F32(float& value) {
+        uint32_t bits;
+        if (!U32(bits)) return false;
+        value = std::bit_cast<float>(bits);
+        return true;
+    }
+    bool Bytes(size_t count, std::string_view& bytes) {
+        if (m_offset + count > m_data.size()) return false;
+        bytes = m_data.substr(m_offset, count);
+        m_offset += count;
+        return true;
+    }
+    bool Position(std::pair<int, int>& position) {
+        uint16_t x, y;
+        if (!U16(x) || !U16(y)) return false;
+        position = { x, y };
+        return true;
+    }
+    size_t Offset() const { return m_offset; }
+    bool AtEnd() const { return m_offset == m_data.size(); }
+
+private:
+    std::string_view m_data;
+    size_t m_offset = 0;
+};
@@ -1,8 +1,7 @@
 #pragma once
-//#include "Character.h"
 #include <chrono>
 #include <iostream>
-import CharacterModule;
+#include "Character.h"
 
 class CapuchinMonkey : public Character
 {
@@ -11,6 +10,5 @@ public:
 	void ActivateSpecialAbility() override;
 	~CapuchinMonkey() = default;
 private:
-	std::chrono::steady_clock::time_point m_abilityStartTime;
 };
 
@@ -0,0 +1,15 @@
+#pragma once
+#include <memory>
+#include "GameState.h"
+#include "InputQueue.h"
+
+// What a game WebSocket is bound to after its join message, stored in the connection's userdata.
+// Input messages go straight to these pointers without looking the game up again.
+struct ClientSession {
+    int playerId;
+    int gameId;
+    std::shared_ptr<GameState> gameState;
+    std::shared_ptr<InputQueue> inputs;
+    int width = 0;  // Last resolution passed to SetResolution
+    int height = 0;
+};
@@ -0,0 +1,282 @@
+#include "ConnectionHub.h"
+#include <crow.h>
+#include <crow/websocket.h>
+#include <algorithm>
+#include <iostream>
+
+ConnectionHub::ConnectionHub() : m_sender(&ConnectionHub::SenderLoop, this)
+{
+}
+
+ConnectionHub::~ConnectionHub()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_sender.joinable()) {
+        m_sender.join();
+    }
+}
+
+bool ConnectionHub::Register(crow::websocket::connection& connection, int gameId, int playerId, uint64_t mapCursor, bool replaceExisting)
+{
+    std::shared_ptr<Client> previous;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_clients.find(&connection) != m_clients.end()) {
+            return true;
+        }
+
+        auto& gameClients = m_gameClients[gameId];
+        if (playerId != PlayerConfig::kDefaultPlayerId) {
+            auto it = std::find_if(gameClients.begin(), gameClients.end(),
+                [playerId](const std::shared_ptr<Client>& other) { return other->playerId == playerId; });
+            if (it != gameClients.end()) {
+                if (!replaceExisting) {
+                    return false;
+                }
+                // Stays in m_clients until its onclose, it just stops getting snapshots
+                previous = std::move(*it);
+                gameClients.erase(it);
+            }
+        }
+
+        auto client = std::make_shared<Client>();
+        client->connection = &connection;
+        client->gameId = gameId;
+        client->playerId = playerId;
+        client->mapCursor = mapCursor;
+        m_clients[&connection] = client;
+        gameClients.push_back(std::move(client));
+    }
+
+    if (previous) {
+        // Usually a reconnect that beat the old socket's timeout, don't leave a ghost behind
+        std::lock_guard<std::mutex> sendLock(previous->sendMutex);
+        if (!previous->closed) {
+            previous->closed = true;
+            ++m_replacedConnections;
+            previous->connection->close("replaced by a new connection");
+        }
+    }
+    return true;
+}
+
+void ConnectionHub::Unregister(crow::websocket::connection& connection)
+{
+    std::shared_ptr<Client> client;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_clients.find(&connection);
+        if (it == m_clients.end()) {
+            return;
+        }
+        client = std::move(it->second);
+        m_clients.erase(it);
+
+        if (auto game = m_gameClients.find(client->gameId); game != m_gameClients.end()) {
+            auto& gameClients = game->second;
+            gameClients.erase(std::remove(gameClients.begin(), gameClients.end(), client), gameClients.end());
+            if (gameClients.empty()) {
+                m_gameClients.erase(game);
+            }
+        }
+    }
+
+    // Crow frees the connection after onclose returns, make sure the sender is done with it
+    std::lock_guard<std::mutex> sendLock(client->sendMutex);
+    client->closed = true;
+    m_replacedSnapshots += client->queue.GetReplacedCount();
+    m_droppedMessages += client->queue.GetOverflowCount();
+}
+
+void ConnectionHub::Acknowledge(crow::websocket::connection& connection, uint64_t receivedCount)
+{
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_clients.find(&connection);
+        if (it == m_clients.end()) {
+            return;
+        }
+        auto& client = it->second;
+        client->receivedCount = receivedCount;
+        client->acknowledges = true;
+        // A held connection only moves again once the client catches up
+        if (client->queue.GetDepth() > 0) {
+            Schedule(client, wake);
+        }
+    }
+    if (wake) {
+        m_wake.notify_one();
+    }
+}
+
+void ConnectionHub::Broadcast(int gameId, const std::string& message, bool isSnapshot)
+{
+    auto payload = std::make_shared<const std::string>(message);
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_gameClients.find(gameId);
+        if (it == m_gameClients.end()) {
+            return;
+        }
+        for (auto& client : it->second) {
+            client->queue.Push(payload, isSnapshot);
+            Schedule(client, wake);
+        }
+    }
+    if (wake) {
+        m_wake.notify_one();
+    }
+}
+
+void ConnectionHub::BroadcastPerPlayer(int gameId, const std::function<std::string_view(int playerId, uint64_t& mapCursor)>& buildMessage)
+{
+    std::vector<std::shared_ptr<Client>> clients;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_gameClients.find(gameId);
+        if (it == m_gameClients.end()) {
+            return;
+        }
+        clients = it->second;
+    }
+
+    // Building is the expensive part, keep the sender thread free to deliver meanwhile
+    for (auto& client : clients) {
+        // The queue keeps its own copy, the builder's buffer is reused for the next client
+        uint64_t previousCursor = client->mapCursor;
+        auto payload = std::make_shared<const std::string>(buildMessage(client->playerId, client->mapCursor));
+        // Map changes are only sent once, replacing this snapshot would lose them
+        client->queue.Push(std::move(payload), client->mapCursor == previousCursor);
+    }
+
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& client : clients) {
+            Schedule(client, wake);
+        }
+    }
+    if (wake) {
+        m_wake.notify_one();
+    }
+}
+
+ConnectionHub::Metrics ConnectionHub::GetMetrics() const
+{
+    Metrics metrics;
+    metrics.sentMessages = m_sentMessages;
+    metrics.shedConnections = m_shedConnections;
+    metrics.replacedSnapshots = m_replacedSnapshots;
+    metrics.droppedMessages = m_droppedMessages;
+    metrics.replacedConnections = m_replacedConnections;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    metrics.connections = m_clients.size();
+    for (const auto& [connection, client] : m_clients) {
+        size_t depth = client->queue.GetDepth();
+        double ageMs = std::chrono::duration<double, std::milli>(client->queue.GetOldestAge()).count();
+        uint64_t inFlight = GetInFlight(*client);
+        metrics.queuedMessages += depth;
+        metrics.maxQueueDepth = std::max(metrics.maxQueueDepth, depth);
+        metrics.maxQueueAgeMs = std::max(metrics.maxQueueAgeMs, ageMs);
+        metrics.inFlightMessages += inFlight;
+        metrics.maxInFlight = std::max(metrics.maxInFlight, inFlight);
+        if (inFlight >= NetworkConfig::kMaxInFlightMessages) {
+            ++metrics.heldConnections;
+        }
+        metrics.replacedSnapshots += client->queue.GetReplacedCount();
+        metrics.droppedMessages += client->queue.GetOverflowCount();
+    }
+    return metrics;
+}
+
+uint64_t ConnectionHub::GetInFlight(const Client& client)
+{
+    if (!client.acknowledges) {
+        return 0;
+    }
+    uint64_t handed = client.handedCount;
+    uint64_t received = client.receivedCount;
+    return handed > received ? handed - received : 0;
+}
+
+void ConnectionHub::Schedule(const std::shared_ptr<Client>& client, bool& wake)
+{
+    if (!client->scheduled.exchange(true)) {
+        m_ready.push_back(client);
+        wake = true;
+    }
+}
+
+void ConnectionHub::SenderLoop()
+{
+    std::vector<std::shared_ptr<Client>> ready;
+    std::vector<OutboundMessage> scratch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stopping || !m_ready.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            ready.swap(m_ready);
+        }
+
+        for (auto& client : ready) {
+            Deliver(*client, scratch);
+        }
+        ready.clear();
+    }
+}
+
+void ConnectionHub::Deliver(Client& client, std::vector<OutboundMessage>& scratch)
+{
+    std::lock_guard<std::mutex> sendLock(client.sendMutex);
+    // Clear the flag first, anything queued from here on schedules the client again
+    client.scheduled = false;
+    if (client.closed) {
+        return;
+    }
+
+    // Only hand Crow what the client has room for, the rest waits in the queue where a newer
+    // snapshot replaces an older one. The next acknowledgement schedules the client again.
+    size_t budget = NetworkConfig::kSendQueueCapacity;
+    if (client.acknowledges) {
+        uint64_t inFlight = GetInFlight(client);
+        budget = inFlight < NetworkConfig::kMaxInFlightMessages ? static_cast<size_t>(NetworkConfig::kMaxInFlightMessages - inFlight) : 0;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (budget > 0) {
+        client.heldSince = {};
+    }
+    else if (client.heldSince == std::chrono::steady_clock::time_point{}) {
+        client.heldSince = now;
+    }
+
+    bool stalled = budget == 0 && now - client.heldSince > std::chrono::milliseconds(NetworkConfig::kMaxSendLagMs);
+    if (stalled || client.queue.HasOverflowed()) {
+        // Too far behind to be worth catching up, the client can reconnect
+        client.closed = true;
+        ++m_shedConnections;
+        std::cerr << "Dropping WebSocket client of game " << client.gameId << ", send queue fell behind" << std::endl;
+        client.connection->close("send queue overflow");
+        return;
+    }
+    if (budget == 0) {
+        return;
+    }
+
+    scratch.clear();
+    client.queue.Pop(scratch, budget);
+    for (const auto& message : scratch) {
+        client.connection->send_text(*message.payload);
+    }
+    client.handedCount += scratch.size();
+    m_sentMessages += scratch.size();
+}
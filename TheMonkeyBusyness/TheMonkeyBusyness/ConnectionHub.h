@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "SendQueue.h"
+
+namespace crow {
+namespace websocket {
+class connection;
+}
+}
+
+// Owns the outgoing side of every game WebSocket. Broadcasts only enqueue, one sender thread
+// hands the payloads to Crow outside of any game lock, so a slow client can't hold up a tick.
+// Crow buffers whatever it is handed without limit and doesn't say when a write finished, so
+// clients report how many messages they received. Once too many are in flight the connection
+// is held back, its snapshots wait (and get replaced) here instead of piling up inside Crow.
+class ConnectionHub
+{
+public:
+    struct Metrics {
+        size_t connections = 0;
+        size_t queuedMessages = 0;
+        size_t maxQueueDepth = 0;
+        double maxQueueAgeMs = 0;
+        uint64_t inFlightMessages = 0;    // Handed to Crow, not reported received yet
+        uint64_t maxInFlight = 0;
+        size_t heldConnections = 0;       // At NetworkConfig::kMaxInFlightMessages, waiting on the client
+        uint64_t sentMessages = 0;
+        uint64_t replacedSnapshots = 0;
+        uint64_t droppedMessages = 0;
+        uint64_t shedConnections = 0;
+        uint64_t replacedConnections = 0;
+    };
+
+    ConnectionHub();
+    ~ConnectionHub();
+    ConnectionHub(const ConnectionHub&) = delete;
+    ConnectionHub& operator=(const ConnectionHub&) = delete;
+
+    // No-op when already registered. playerId is handed back to BroadcastPerPlayer, mapCursor is
+    // where the connection starts in the map change log (a resumed client picks up where it was).
+    // When the player already has a connection in the game, replaceExisting closes that one and
+    // takes its place, otherwise nothing is registered and this returns false.
+    bool Register(crow::websocket::connection& connection, int gameId, int playerId = PlayerConfig::kDefaultPlayerId,
+        uint64_t mapCursor = 0, bool replaceExisting = false);
+    void Unregister(crow::websocket::connection& connection); // Call from onclose
+    // receivedCount is how many messages the client got on this connection. Connections that
+    // never report it (older clients) aren't held back, only dropped when their queue overflows.
+    void Acknowledge(crow::websocket::connection& connection, uint64_t receivedCount);
+
+    // Queues a message for every connection of the game. Snapshots replace unsent snapshots.
+    void Broadcast(int gameId, const std::string& message, bool isSnapshot = true);
+    // Queues a snapshot built separately for each connection of the game. buildMessage runs on
+    // the calling thread without the hub's lock, so it can read game state under the caller's lock.
+    // The view it returns is copied before the next call, it can point into a reused buffer.
+    // mapCursor is the connection's own position in the game's map change log, 0 for a new
+    // connection. A snapshot that moved it carries changes and is never replaced by a later one.
+    void BroadcastPerPlayer(int gameId, const std::function<std::string_view(int playerId, uint64_t& mapCursor)>& buildMessage);
+
+    Metrics GetMetrics() const;
+
+private:
+    struct Client {
+        crow::websocket::connection* connection;
+        int gameId;
+        int playerId;
+        uint64_t mapCursor = 0;           // Only used by BroadcastPerPlayer, which runs on the game's loop thread
+        SendQueue queue;
+        std::mutex sendMutex;             // Held while handing messages to Crow, Unregister waits on it
+        bool closed = false;              // Guarded by sendMutex
+        std::chrono::steady_clock::time_point heldSince{}; // Guarded by sendMutex, default while not held
+        std::atomic<uint64_t> handedCount{ 0 };   // Messages given to Crow
+        std::atomic<uint64_t> receivedCount{ 0 }; // Last count the client reported
+        std::atomic<bool> acknowledges{ false };  // Client reports receivedCount at all
+        std::atomic<bool> scheduled{ false }; // Already in m_ready
+    };
+
+    std::unordered_map<crow::websocket::connection*, std::shared_ptr<Client>> m_clients;
+    std::unordered_map<int, std::vector<std::shared_ptr<Client>>> m_gameClients;
+    std::vector<std::shared_ptr<Client>> m_ready; // Clients with queued messages
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::thread m_sender;
+
+    std::atomic<uint64_t> m_sentMessages{ 0 };
+    std::atomic<uint64_t> m_shedConnections{ 0 };
+    std::atomic<uint64_t> m_replacedSnapshots{ 0 }; // Totals of connections already gone
+    std::atomic<uint64_t> m_droppedMessages{ 0 };
+    std::atomic<uint64_t> m_replacedConnections{ 0 };
+
+    static uint64_t GetInFlight(const Client& client); // 0 for clients that don't acknowledge
+    void Schedule(const std::shared_ptr<Client>& client, bool& wake); // Caller holds m_mutex
+    void SenderLoop();
+    void Deliver(Client& client, std::vector<OutboundMessage>& scratch);
+};
@@ -14,6 +14,7 @@ namespace PlayerConfig {
     constexpr float kDefaultPositionX = 0.0f;
     constexpr float kDefaultPositionY = 0.0f;
     constexpr const char* kDefaultPlayerName = "Mario";
+    constexpr const char* kUnknownPlayerName = "UnknownPlayer"; // Players missing from the user database
 }
 
 // Weapon Configuration
@@ -32,6 +33,9 @@ namespace GameConfig {
     constexpr int kMinLobbyPlayers = 1;      //TEMPORARY FOR DEBUGGING, LET THE GAME START WITH 1 PLAYER NOW. CHANGE TO 2 PLAYERS WHEN WORKING
     constexpr int kMaxLobbyPlayers = 4;
     constexpr int kFrameDurationMs = 16;     // ~60 FPS
+    constexpr float kFixedDeltaTime = kFrameDurationMs / 1000.0f; // Seconds simulated by every tick
+    constexpr int kMaxCatchUpTicks = 5;      // Ticks run back to back after a stall, older backlog is dropped
+    constexpr int kFrameArenaBytes = 16 * 1024;  // Starting size of each game's per-tick scratch memory
     constexpr int kRaycastRange = 15;
     constexpr int kBulletRaycastRange = 5;
 
@@ -40,6 +44,29 @@ namespace GameConfig {
     constexpr int kTileSize = 40;          // Size of a single grid tile
     constexpr float kDefaultRotationOffset = 90.0f; // Offset for rotation calculations
 
+    constexpr int kArenaDim = 50;            // Tiles per side of a match arena
+    constexpr int kArenaSpawns = 10;         // Spawn points generated per arena
+    constexpr int kArenaPoolSize = 4;        // Ready arenas kept per (size, spawns) config
+
     constexpr float kfirstLobbyId = 1;   // Lobby unique IDs start from 1
     constexpr float kfirstGameId = 1;    // Game bby unique IDs start from 1
 }
+
+// Network Configuration
+namespace NetworkConfig {
+    constexpr int kSendQueueCapacity = 64;         // Messages waiting per connection before it counts as overflowing
+    constexpr int kMaxInFlightMessages = 16;       // Handed to Crow but not reported received yet, more and the connection is held back
+    constexpr int kMaxSendLagMs = 2000;            // Held back this long and the client is dropped
+    constexpr int kViewMargin = 4 * GameConfig::kTileSize; // Around the client's screen, entities inside are sent in full
+    constexpr int kFarUpdateInterval = 10;         // Players outside the view are sent every this many snapshots
+    constexpr int kInputHoldTicks = 30;            // Ticks the last movement is repeated without a new message
+    constexpr int kMapChangeLogCapacity = 1024;    // Map changes kept per game, clients further behind resync the arena
+}
+
+// Replay Configuration
+namespace ReplayConfig {
+    constexpr bool kRecordReplays = true;
+    constexpr const char* kReplayDirectory = "replays";
+    constexpr int kFlushBytes = 64 * 1024;         // Buffered per match before it goes to the writer thread
+    constexpr int kFlushIntervalMs = 1000;         // Flushed at least this often, so a crash loses little
+}
@@ -0,0 +1,60 @@
+#include "FrameAllocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+FrameAllocator::FrameAllocator(size_t capacity) : m_buffer{ std::make_unique<std::byte[]>(capacity) }, m_capacity{ capacity }
+{
+}
+
+void FrameAllocator::Rewind()
+{
+    m_peakBytes = std::max(m_peakBytes, m_used + m_overflowBytes);
+    for (const auto& [block, layout] : m_overflow) {
+        ::operator delete(block, layout.first, std::align_val_t(layout.second));
+    }
+    m_overflow.clear();
+
+    if (m_overflowBytes > 0) {
+        // Grow once to what this frame needed, with room to spare, instead of spilling every tick
+        m_capacity = std::max(m_capacity * 2, (m_used + m_overflowBytes) * 2);
+        m_buffer = std::make_unique<std::byte[]>(m_capacity);
+    }
+    m_used = 0;
+    m_overflowBytes = 0;
+}
+
+size_t FrameAllocator::GetCapacity() const
+{
+    return m_capacity;
+}
+
+size_t FrameAllocator::GetPeakBytes() const
+{
+    return std::max(m_peakBytes, m_used + m_overflowBytes);
+}
+
+void* FrameAllocator::do_allocate(size_t bytes, size_t alignment)
+{
+    auto base = reinterpret_cast<uintptr_t>(m_buffer.get());
+    size_t start = static_cast<size_t>(((base + m_used + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+    if (start + bytes <= m_capacity) {
+        m_used = start + bytes;
+        return m_buffer.get() + start;
+    }
+
+    void* block = ::operator new(bytes, std::align_val_t(alignment));
+    m_overflow.push_back({ block, { bytes, alignment } });
+    m_overflowBytes += bytes;
+    return block;
+}
+
+void FrameAllocator::do_deallocate(void*, size_t, size_t)
+{
+    // Freed all at once by Rewind
+}
+
+bool FrameAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
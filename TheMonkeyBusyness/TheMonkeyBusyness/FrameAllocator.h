@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include "ConstantValues.h"
+
+// Scratch memory for one tick of one game, for std::pmr containers that only live during the tick.
+// Allocation bumps a pointer, deallocation does nothing, Rewind() hands everything back at once.
+// Every game owns its own and only its loop thread touches it, so ticks of different games never
+// meet in the global heap. A tick that needs more than the buffer takes the rest from the heap,
+// the next Rewind() grows the buffer so the following ticks fit again.
+class FrameAllocator : public std::pmr::memory_resource
+{
+public:
+    explicit FrameAllocator(size_t capacity = GameConfig::kFrameArenaBytes);
+    FrameAllocator(FrameAllocator&&) = default;
+    FrameAllocator& operator=(FrameAllocator&&) = default;
+
+    void Rewind(); // Nothing allocated since the last Rewind may be used afterwards
+
+    size_t GetCapacity() const;
+    size_t GetPeakBytes() const; // Most bytes one frame has needed so far
+
+private:
+    std::unique_ptr<std::byte[]> m_buffer;
+    size_t m_capacity;
+    size_t m_used = 0;
+    size_t m_overflowBytes = 0; // Taken from the heap this frame
+    size_t m_peakBytes = 0;
+    std::vector<std::pair<void*, std::pair<size_t, size_t>>> m_overflow; // Block, size and alignment
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
@@ -1,38 +1,73 @@
 #include "GameManager.h"
 #include "LobbyManager.h"
+#include "ReplayFormat.h"
+#include "UserDatabase.h"
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 extern std::shared_ptr<LobbyManager> lobbyManager;
 
-GameManager::GameManager() : m_nextGameId(GameConfig::kfirstGameId), m_deltaTime(0.0f) {}
+GameManager::GameManager() : m_nextGameId(GameConfig::kfirstGameId), m_arenaPool(std::make_shared<ArenaPool>()) {
+    m_arenaPool->Prewarm();
+    if (ReplayConfig::kRecordReplays) {
+        m_replayWriter = std::make_shared<ReplayWriter>();
+    }
+}
 
 GameManager::~GameManager() {
-    for (auto& [gameId, _] : m_games) {
-        StopGameLoop(gameId);
+    // Ids first, a loop ending its match erases itself from m_games meanwhile
+    std::vector<int> gameIds;
+    {
+        std::lock_guard<std::mutex> lock(m_gameMutex);
+        for (const auto& [gameId, gameState] : m_games) {
+            gameIds.push_back(gameId);
+        }
+    }
+    for (int gameId : gameIds) {
+        DeleteGame(gameId);
     }
 }
 
 int GameManager::CreateGameFromLobby(int lobbyId) {
-    std::lock_guard<std::mutex> lock(m_gameMutex);
-
-    int gameId = m_nextGameId++;
-
     auto lobby = lobbyManager->GetLobby(lobbyId);
     if (!lobby) {
         throw std::runtime_error("Lobby not found");
     }
 
-    // Create game state and add all lobby players
-    auto gameState = std::make_shared<GameState>();
+    // Take a pre-generated arena and set the game up before taking m_gameMutex,
+    // so running games keep ticking while a new match starts
+    auto gameState = std::make_shared<GameState>(m_arenaPool->Acquire());
+
+    // Add all lobby players, names come from the user database so the simulation doesn't need it
     const auto& playersMap = lobby->GetPlayers();
+    UserDatabase database("userdatabase.db");
     for (const auto& [playerId, isReady] : playersMap) {
-        gameState->AddPlayer(playerId);
+        std::string name = database.GetUsernameById(playerId);
+        if (name.empty()) {
+            std::cerr << "Player ID " << playerId << " not found in the database." << std::endl;
+            name = PlayerConfig::kUnknownPlayerName;
+        }
+        gameState->AddPlayer(playerId, name);
     }
+    auto lobbyTokens = lobby->GetResumeTokens();
 
+    std::lock_guard<std::mutex> lock(m_gameMutex);
+
+    int gameId = m_nextGameId++;
+    if (m_replayWriter) {
+        // Only buffers, the file is created on the writer thread
+        auto startTime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        std::string path = std::string(ReplayConfig::kReplayDirectory) + "/game_" + std::to_string(gameId) + "_" + std::to_string(startTime) + ReplayFormat::kExtension;
+        gameState->StartRecording(std::make_shared<ReplayRecorder>(m_replayWriter, path));
+    }
     m_games[gameId] = gameState;
-    m_runningGames[gameId] = false;
+    auto& tokens = m_gameResumeTokens[gameId];
+    for (auto& [playerId, token] : lobbyTokens) {
+        m_resumeTokens[token] = { gameId, playerId };
+        tokens[playerId] = std::move(token);
+    }
 
     return gameId;
 }
@@ -43,48 +78,83 @@ void GameManager::DeleteGame(int gameId) {
     std::lock_guard<std::mutex> lock(m_gameMutex);
     auto it = m_games.find(gameId);
     if (it != m_games.end()) {
+        it->second->StopRecording();
         m_games.erase(it);
         m_gameThreads.erase(gameId);
         m_runningGames.erase(gameId);
+        if (auto tokens = m_gameResumeTokens.find(gameId); tokens != m_gameResumeTokens.end()) {
+            for (const auto& [playerId, token] : tokens->second) {
+                m_resumeTokens.erase(token);
+            }
+            m_gameResumeTokens.erase(tokens);
+        }
     }
 }
 
 bool GameManager::StartGameLoop(int gameId) {
     std::lock_guard<std::mutex> lock(m_gameMutex);
 
-    if (m_runningGames[gameId]) {
+    auto game = m_games.find(gameId);
+    if (game == m_games.end()) {
+        return false;
+    }
+
+    auto& running = m_runningGames[gameId];
+    if (running && *running) {
         return true;
     }
 
-    m_runningGames[gameId] = true;
+    running = std::make_shared<std::atomic<bool>>(true);
 
     try {
-        m_gameThreads[gameId] = std::thread(&GameManager::GameLoop, this, gameId);
+        m_gameThreads[gameId] = std::thread(&GameManager::GameLoop, this, gameId, game->second, running);
         return true;  // Successfully started the game loop
     }
     catch (const std::exception& e) {
-        m_runningGames[gameId] = false;  // Reset the state if starting the thread fails
+        *running = false;  // Reset the state if starting the thread fails
         return false;  // Indicate failure
     }
 }
 
 void GameManager::StopGameLoop(int gameId) {
-    std::lock_guard<std::mutex> lock(m_gameMutex);
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(m_gameMutex);
+
+        auto running = m_runningGames.find(gameId);
+        if (running == m_runningGames.end() || !*running->second) {
+            return;
+        }
 
-    if (!m_runningGames[gameId]) {
-        return;
+        *running->second = false;
+        if (auto it = m_gameThreads.find(gameId); it != m_gameThreads.end()) {
+            thread = std::move(it->second);
+            m_gameThreads.erase(it);
+        }
     }
 
-    m_runningGames[gameId] = false;
-    if (m_gameThreads[gameId].joinable()) {
-        m_gameThreads[gameId].join();
+    // Joined outside the lock, the loop may be finishing a tick and other games keep going.
+    // A loop ending its own match can't join itself, it returns right after this
+    if (thread.joinable()) {
+        if (thread.get_id() == std::this_thread::get_id()) {
+            thread.detach();
+        }
+        else {
+            thread.join();
+        }
     }
-    m_gameThreads.erase(gameId);
 }
 
-float GameManager::GetDeltaTime()
+void GameManager::SetSimulationSpeed(float speed)
 {
-    return m_deltaTime;
+    if (speed > 0.0f) {
+        m_simulationSpeed = speed;
+    }
+}
+
+void GameManager::SetTickListener(TickListener listener)
+{
+    m_tickListener = std::move(listener);
 }
 
 std::unordered_map<int, std::shared_ptr<GameState>> GameManager::GetAllGames()
@@ -103,37 +173,70 @@ std::shared_ptr<GameState> GameManager::GetGameState(int gameId) {
     return nullptr;
 }
 
-void GameManager::GameLoop(int gameId) {
-    const std::chrono::milliseconds frameDuration(GameConfig::kFrameDurationMs);
-    auto previousTime = std::chrono::steady_clock::now();
-    std::chrono::nanoseconds totalTime = std::chrono::nanoseconds::zero();
+std::string GameManager::GetResumeToken(int gameId, int playerId)
+{
+    std::lock_guard<std::mutex> lock(m_gameMutex);
+    auto game = m_gameResumeTokens.find(gameId);
+    if (game == m_gameResumeTokens.end()) {
+        return {};
+    }
+    auto token = game->second.find(playerId);
+    return token != game->second.end() ? token->second : std::string();
+}
 
-    while (m_runningGames[gameId]) {
-        auto currentTime = std::chrono::steady_clock::now();
+bool GameManager::FindResumeToken(const std::string& token, int& gameId, int& playerId)
+{
+    std::lock_guard<std::mutex> lock(m_gameMutex);
+    auto it = m_resumeTokens.find(token);
+    if (it == m_resumeTokens.end()) {
+        return false;
+    }
+    gameId = it->second.gameId;
+    playerId = it->second.playerId;
+    return true;
+}
 
-        // Accumulate elapsed time
-        totalTime += (currentTime - previousTime);
+void GameManager::GameLoop(int gameId, std::shared_ptr<GameState> gameState, std::shared_ptr<std::atomic<bool>> running) {
+    // Fixed timestep: every tick simulates exactly the game's delta time, wall time only decides
+    // how many ticks are due. The same inputs give the same match however loaded the machine is.
+    // The accumulator lives on this game's own thread, the tick count and delta time in its GameState.
+    using Clock = std::chrono::steady_clock;
+    auto previousTime = Clock::now();
+    Clock::duration accumulator = Clock::duration::zero();
+    // Only a match that was still open can end, a game started with one player just keeps running
+    bool wasGameOver = gameState->IsGameOver();
+
+    while (*running) {
+        const auto tickDuration = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(gameState->GetDeltaTime() / m_simulationSpeed));
+
+        auto currentTime = Clock::now();
+        accumulator += currentTime - previousTime;
         previousTime = currentTime;
 
-        // Check if enough time has passed for a frame
-        if (totalTime >= std::chrono::duration_cast<std::chrono::nanoseconds>(frameDuration)) {
-            // Calculate deltaTime in seconds
-            m_deltaTime = std::chrono::duration_cast<std::chrono::duration<float>>(totalTime).count();
-
-            // Update the game state with deltaTime
-            {
-                std::lock_guard<std::mutex> lock(m_gameMutex);
-                auto it = m_games.find(gameId);
-                if (it != m_games.end()) {
-                    it->second->UpdateGame(m_deltaTime);
-                }
-                else {
-                    break;
-                }
-            }
+        int ticks = 0;
+        while (accumulator >= tickDuration && ticks < GameConfig::kMaxCatchUpTicks) {
+            gameState->Tick();
+            accumulator -= tickDuration;
+            ++ticks;
+        }
+        // After a long stall, drop what can't be caught up instead of spiraling
+        if (accumulator >= tickDuration) {
+            accumulator = Clock::duration::zero();
+        }
+        // One snapshot per iteration, catch-up ticks don't each need one
+        if (ticks > 0 && m_tickListener) {
+            m_tickListener(gameId, *gameState);
+        }
 
-            // Reset totalTime after processing the frame
-            totalTime = std::chrono::nanoseconds::zero();
+        // The last snapshot (with isGameOver) is queued, close the replay and drop the game
+        if (ticks > 0 && !wasGameOver && gameState->IsGameOver()) {
+            std::cout << "Game " << gameId << " over after " << gameState->GetTickIndex() << " ticks" << std::endl;
+            gameState->StopRecording();
+            DeleteGame(gameId);
+            return;
         }
+
+        std::this_thread::sleep_for(tickDuration - accumulator);
     }
 }
@@ -1,12 +1,20 @@
 #pragma once
 #include <unordered_map>
+#include <atomic>
+#include <functional>
 #include <thread>
 #include <mutex>
 #include <memory>
+#include <string>
 #include "GameState.h"
+#include "ArenaPool.h"
+#include "ReplayWriter.h"
 
 class GameManager {
 public:
+    // Runs on a game's loop thread after the ticks of one loop iteration, the only thread touching that game
+    using TickListener = std::function<void(int gameId, GameState& gameState)>;
+
     GameManager();
     ~GameManager();
 
@@ -17,19 +25,35 @@ public:
     // Update loop
     bool StartGameLoop(int gameId);
     void StopGameLoop(int gameId);
-    float GetDeltaTime();
+    // Ticks per wall-clock tick interval, above 1 games run faster than real time (bots, soak tests).
+    // The simulation itself doesn't change, every tick is still kFixedDeltaTime.
+    void SetSimulationSpeed(float speed);
+    void SetTickListener(TickListener listener); // Set before any game loop starts
     std::unordered_map<int, std::shared_ptr<GameState>> GetAllGames();
     // Access game state
     std::shared_ptr<GameState> GetGameState(int gameId);
+    // Resume tokens come from the lobby (one per player, handed out when they entered it) and are
+    // dropped with the game. A client that lost its WebSocket rebinds with its token.
+    std::string GetResumeToken(int gameId, int playerId); // Empty for players not in the game
+    bool FindResumeToken(const std::string& token, int& gameId, int& playerId); // False for unknown tokens
 
 private:
     std::unordered_map<int, std::shared_ptr<GameState>> m_games;
     std::unordered_map<int, std::thread> m_gameThreads;
-    std::unordered_map<int, bool> m_runningGames;
+    std::unordered_map<int, std::shared_ptr<std::atomic<bool>>> m_runningGames; // Read by each game's loop without m_gameMutex
     std::mutex m_gameMutex;
-    float m_deltaTime;
+    std::atomic<float> m_simulationSpeed{ 1.0f };
     int m_nextGameId;
+    std::shared_ptr<ArenaPool> m_arenaPool;
+    std::shared_ptr<ReplayWriter> m_replayWriter; // nullptr when ReplayConfig::kRecordReplays is off
+    TickListener m_tickListener;
+    struct ResumeTarget {
+        int gameId;
+        int playerId;
+    };
+    std::unordered_map<std::string, ResumeTarget> m_resumeTokens;
+    std::unordered_map<int, std::unordered_map<int, std::string>> m_gameResumeTokens; // gameId -> playerId -> token
 
 private:
-    void GameLoop(int gameId);
+    void GameLoop(int gameId, std::shared_ptr<GameState> gameState, std::shared_ptr<std::atomic<bool>> running);
 };
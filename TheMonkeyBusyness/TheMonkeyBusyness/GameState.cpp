@@ -1,21 +1,64 @@
 ﻿#include "GameState.h"
-#include "UserDatabase.h"
 #include <stdexcept>
-#include <crow.h>
 #include <chrono>
-#include <iostream>
-import TileTypeModule;
-void GameState::AddPlayer(int playerId) {
+#include "TileType.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <set>
+
+namespace {
+
+// What a client can see: its screen centered on its player, grown by NetworkConfig::kViewMargin
+// so things entering the screen are already known
+struct ViewRect {
+    float minX = -std::numeric_limits<float>::infinity();
+    float minY = -std::numeric_limits<float>::infinity();
+    float maxX = std::numeric_limits<float>::infinity();
+    float maxY = std::numeric_limits<float>::infinity();
+
+    bool Contains(const Vector2<float>& position) const {
+        return position.x >= minX && position.x <= maxX && position.y >= minY && position.y <= maxY;
+    }
+};
+
+ViewRect MakeViewRect(const Player& viewer) {
+    Vector2<float> center = viewer.GetPosition();
+    float halfWidth = viewer.GetScreenWidth() / 2.0f + NetworkConfig::kViewMargin;
+    float halfHeight = viewer.GetScreenHeight() / 2.0f + NetworkConfig::kViewMargin;
+    return { center.x - halfWidth, center.y - halfHeight, center.x + halfWidth, center.y + halfHeight };
+}
+
+}
+
+void GameState::AddPlayer(int playerId, const std::string& name) {
+    if (m_players->find(playerId) != m_players->end()) {
+        throw std::runtime_error("Player ID already exists");
+    }
+    AddPlayer(InitializePlayer(playerId, name));
+}
+
+void GameState::AddPlayer(const Player& player) {
+    int playerId = player.GetId();
     if (m_players->find(playerId) != m_players->end()) {
         throw std::runtime_error("Player ID already exists");
     }
     m_raycast.m_arena = m_arena;
     m_raycast.m_players = m_players;
-    (*m_players)[playerId] = InitializePlayer(playerId);
+    (*m_players)[playerId] = player;
+    m_inputQueues[playerId] = std::make_shared<InputQueue>();
+    if (m_recorder) {
+        m_recorder->RecordPlayer(playerId, player.GetMonkeyType(), player.GetPosition(), player.GetName());
+    }
 }
 
 void GameState::RemovePlayer(int playerId) {
     m_players->erase(playerId);
+    m_inputQueues.erase(playerId);
+    if (m_recorder) {
+        m_recorder->RecordRemovePlayer(playerId);
+    }
 }
 
 Player* GameState::GetPlayer(int playerId) {
@@ -23,8 +66,7 @@ Player* GameState::GetPlayer(int playerId) {
     return (it != m_players->end()) ? &(it->second) : nullptr;
 }
 
-Player GameState::InitializePlayer(int playerId) {
-    std::string playerName = GetPlayerNameFromDatabase(playerId);
+Player GameState::InitializePlayer(int playerId, const std::string& playerName) {
     bool isOverlapping = false;
     std::pair<int, int> spawn;
     do {
@@ -45,21 +87,6 @@ Player GameState::InitializePlayer(int playerId) {
         playerId, playerName);
 }
 
-std::string GameState::GetPlayerNameFromDatabase(int playerId) {
-    UserDatabase database("userdatabase.db");
-
-    // Obține username-ul din baza de date pe baza playerId-ului
-    std::string username = database.GetUsernameById(playerId);
-
-    // Verifică dacă username-ul a fost găsit
-    if (username.empty()) {
-        std::cerr << "Player ID " << playerId << " not found in the database." << std::endl;
-        return "UnknownPlayer"; // Returnează un nume generic dacă nu există în baza de date
-    }
-
-    return username; // Returnează numele utilizatorului
-}
-
 bool GameState::IsGameOver() const {
     int count=0;
     for (auto& [playerId, player] : *m_players) {
@@ -68,7 +95,6 @@ bool GameState::IsGameOver() const {
         }
     }
     if (count < 2) {
-        std::cout << "Game Over!!!";
         return true;
     }
     else {
@@ -125,10 +151,51 @@ void GameState::ProcessShoot(int playerId, const Vector2<float>& mousePosition)
         return; // Player not found
     }
     if (player->IsAlive()) {
-        player->Shoot(mousePosition);
+        player->Shoot(mousePosition, m_bullets);
     }
 }
 
+std::shared_ptr<InputQueue> GameState::GetInputQueue(int playerId)
+{
+    auto it = m_inputQueues.find(playerId);
+    return it != m_inputQueues.end() ? it->second : nullptr;
+}
+
+void GameState::TakeInputs(float deltaTime, std::pmr::vector<std::pair<int, PlayerInput>>& inputs)
+{
+    for (auto& [playerId, player] : *m_players) {
+        auto it = m_inputQueues.find(playerId);
+        if (it == m_inputQueues.end()) {
+            continue;
+        }
+        int width, height;
+        if (it->second->TakeResolution(width, height)) {
+            SetResolution(width, height, playerId);
+        }
+        PlayerInput input;
+        bool isFresh = false;
+        if (!it->second->Take(input, &isFresh)) {
+            continue;
+        }
+        // Held input repeats by itself on replay, only what the client actually sent is recorded
+        if (isFresh && m_recorder) {
+            m_recorder->RecordInput(playerId, input, deltaTime);
+        }
+        inputs.emplace_back(playerId, input);
+    }
+}
+
+void GameState::ApplyInput(int playerId, const PlayerInput& input, float deltaTime)
+{
+    if (input.isShooting) {
+        ProcessShoot(playerId, input.mousePosition);
+    }
+    if (input.isSpecialAbility) {
+        SpecialAbility(playerId);
+    }
+    ProcessMove(playerId, input.movement, input.mousePosition, deltaTime);
+}
+
 void GameState::SpecialAbility(int playerId)
 {
     Player* player = GetPlayer(playerId);
@@ -140,119 +207,322 @@ void GameState::SpecialAbility(int playerId)
 
 void GameState::UpdateGame(float deltaTime)
 {
+    Step(deltaTime);
+    // Step's containers are gone, the tick's scratch memory can be handed back
+    m_frame.Rewind();
+    if (m_mapChanges.Size() > NetworkConfig::kMapChangeLogCapacity) {
+        m_mapChanges.Compact(NetworkConfig::kMapChangeLogCapacity / 2);
+    }
+}
+
+void GameState::Step(float deltaTime)
+{
+    // Inputs are recorded ahead of their tick, a replay queues them and lets this tick take them
+    std::pmr::vector<std::pair<int, PlayerInput>> inputs(&m_frame);
+    TakeInputs(deltaTime, inputs);
+    if (m_recorder) {
+        m_recorder->RecordTick(deltaTime);
+    }
+    for (const auto& [playerId, input] : inputs) {
+        ApplyInput(playerId, input, deltaTime);
+    }
     for (auto& [playerId, player] : *m_players) {
         player.Update(deltaTime);
-        player.UpdateDot();
+        player.UpdateDot(deltaTime);
         player.IsAlive();
     }
 
     UpdateBullets(deltaTime);
 }
 
+void GameState::Tick()
+{
+    UpdateGame(m_deltaTime);
+    ++m_tickIndex;
+    m_simulatedTime += m_deltaTime;
+}
+
+float GameState::GetDeltaTime() const
+{
+    return m_deltaTime;
+}
+
+uint64_t GameState::GetTickIndex() const
+{
+    return m_tickIndex;
+}
+
+double GameState::GetSimulatedTime() const
+{
+    return m_simulatedTime;
+}
+
 void GameState::SetResolution(int width, int height, int playerId)
 {
+    if (m_recorder) {
+        m_recorder->RecordResolution(playerId, width, height);
+    }
     (*m_players)[playerId].SetScreenSize(width, height);
 }
 
+size_t GameState::GetBulletCount() const
+{
+    return m_bullets.Size();
+}
+
+const std::string& GameState::WriteSnapshot(int viewerId, bool includeFar, uint64_t& mapCursor)
+{
+    // Unknown viewers (spectators, stale sessions) see everything
+    ViewRect view;
+    if (auto viewer = m_players->find(viewerId); viewer != m_players->end()) {
+        view = MakeViewRect(viewer->second);
+    }
+
+    // Only bullets in view are sent, a far player still gets an entry when its bullets are near
+    m_visibleBullets.clear();
+    for (size_t i = 0; i < m_bullets.Size(); ++i) {
+        if (view.Contains(m_bullets.GetPosition(i))) {
+            m_visibleBullets.push_back(i);
+        }
+    }
+
+    SnapshotWriter& writer = m_snapshotWriter;
+    writer.Reset();
+    writer.BeginObject();
+    writer.Key("players");
+    writer.BeginArray();
+    for (const auto& [playerId, player] : *m_players) {
+        bool hasBullets = std::any_of(m_visibleBullets.begin(), m_visibleBullets.end(),
+            [&](size_t index) { return m_bullets.GetOwner(index) == playerId; });
+        bool inView = playerId == viewerId || view.Contains(player.GetPosition());
+        if (!inView && !includeFar && !hasBullets) {
+            continue;
+        }
+
+        writer.BeginObject();
+        if (inView) {
+            player.WriteSnapshot(writer);
+        }
+        else {
+            // Coarse entry, enough to place the player on the map
+            writer.Key("id");
+            writer.Int(playerId);
+            writer.Key("name");
+            writer.String(player.GetName());
+            writer.Key("x");
+            writer.Int(static_cast<int>(std::round(player.GetPosition().x)));
+            writer.Key("y");
+            writer.Int(static_cast<int>(std::round(player.GetPosition().y)));
+            writer.Key("isAlive");
+            writer.Int(player.GetCharacter()->GetHealth() > 0 ? 1 : 0);
+        }
+        // Bullets live in one game-wide buffer, group them back under their owner's weapon
+        writer.Key("weapon");
+        writer.BeginObject();
+        writer.Key("bullets");
+        writer.BeginArray();
+        for (size_t index : m_visibleBullets) {
+            if (m_bullets.GetOwner(index) == playerId) {
+                m_bullets.WriteSnapshot(index, writer);
+            }
+        }
+        writer.EndArray();
+        writer.EndObject();
+        writer.EndObject();
+    }
+    writer.EndArray();
+
+    if (m_mapChanges.IsCompacted(mapCursor)) {
+        // Fell behind the log, the client fetches what it missed on its own
+        writer.Key("arenaResync");
+        writer.Bool(true);
+    }
+    writer.Key("mapChanges");
+    writer.BeginArray();
+    for (const auto& change : m_mapChanges.Since(mapCursor)) {
+        writer.BeginObject();
+        writer.Key("x");
+        writer.Int(change.position.first);
+        writer.Key("y");
+        writer.Int(change.position.second);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    uint64_t version = m_mapChanges.GetVersion();
+    if (version != mapCursor) {
+        writer.Key("arenaVersion");
+        writer.Int(static_cast<int64_t>(version));
+        mapCursor = version;
+    }
+    writer.Key("isGameOver");
+    writer.Bool(IsGameOver());
+    writer.EndObject();
+    return writer.GetBuffer();
+}
+
+const MapChangeLog& GameState::GetMapChanges() const
+{
+    return m_mapChanges;
+}
+
+uint64_t GameState::GetArenaVersion() const
+{
+    return m_mapChanges.GetVersion();
+}
+
+uint64_t GameState::NextSnapshotIndex()
+{
+    return m_snapshotIndex++;
+}
+
 void GameState::UpdateBullets(float deltaTime) {
+    m_bullets.Integrate(deltaTime);
+
+    // Broad phase: collect the players once per update instead of walking the map for every bullet
+    std::pmr::vector<std::pair<int, Player*>> targets(&m_frame);
+    targets.reserve(m_players->size());
     for (auto& [playerId, player] : *m_players) {
-        auto& bullets = player.m_weapon.GetActiveBullets();
-        for (size_t i = 0; i < bullets.size();) {
-            auto& bullet = bullets[i];
-            bullet.Update(deltaTime);
-            Vector2<float> RayCastLocation;
-            if (GameObject* hit = m_raycast.Raycast(bullet.GetPosition(), bullet.GetDirection(), GameConfig::kBulletRaycastRange, player); Player * tempPlayer = dynamic_cast<Player*>(hit)) {
-                    tempPlayer->Damage(bullet.GetDamage());
-                    player.m_weapon.deactivateBullet(i);
+        targets.emplace_back(playerId, &player);
+    }
+
+    // Deactivate swaps the last bullet into slot i, so i only advances for bullets that stay alive
+    for (size_t i = 0; i < m_bullets.Size();) {
+        int ownerId = m_bullets.GetOwner(i);
+        float damage = m_bullets.GetDamage(i);
+        Vector2<float> RayCastLocation = m_bullets.GetPosition(i) + m_bullets.GetDirection(i) * static_cast<float>(GameConfig::kBulletRaycastRange);
+
+        Player* hitPlayer = nullptr;
+        for (auto& [targetId, target] : targets) {
+            float dx = RayCastLocation.x - target->GetPosition().x;
+            float dy = RayCastLocation.y - target->GetPosition().y;
+            if (targetId != ownerId && dx * dx + dy * dy <= PlayerConfig::kPlayerSize * PlayerConfig::kPlayerSize && target->IsAlive()) {
+                hitPlayer = target;
+                break;
             }
-            if (GameObject* hit = m_raycast.Raycast(bullet.GetPosition(), bullet.GetDirection(), GameConfig::kBulletRaycastRange, player, RayCastLocation); Tile * tempTile = dynamic_cast<Tile*>(hit)) {
-                TileType tempType = tempTile->getType();
-                if (tempType == TileType::DestructibleWall || tempType == TileType::FakeDestructibleWall)
-                {
-                    tempTile->takeDamage(bullet.GetDamage());
-                    if (tempTile->getHP() <= 0) {
-                        int x = (std::floor(RayCastLocation.x / GameConfig::kTileSize));
-                        int y = (std::floor(RayCastLocation.y / GameConfig::kTileSize));
-                        if (tempType == TileType::FakeDestructibleWall) {
-                            // Apply damage to players and destructible tiles in the area around the tile
-                            for (int dx = -1; dx <= 1; ++dx) {
-                                for (int dy = -1; dy <= 1; ++dy) {
-                                    int checkX = y + dy;
-                                    int checkY = x + dx;
-
-                                    for (auto& [playerId, player] : *m_players) {
-                                        // Check if the player's position overlaps with the tile's surrounding area
-                                        if ((int)player.GetPosition().y / GameConfig::kTileSize == checkX &&
-                                            (int)player.GetPosition().x / GameConfig::kTileSize == checkY) {
-                                            // Apply damage to the player
-                                            player.Damage(40);
-                                        }
-                                    }
-
-                                    Tile* surroundingTile = &m_arena->GetTile(checkX, checkY);
-                                    if (surroundingTile->getType() == TileType::FakeDestructibleWall || surroundingTile->getType() == TileType::DestructibleWall)
-                                    {
-                                        surroundingTile->takeDamage(30);
-                                        m_mapChanges.push_back({ checkY, checkX });
-                                    }
+        }
+        if (hitPlayer) {
+            hitPlayer->Damage(damage);
+            m_bullets.Deactivate(i);
+            continue;
+        }
+
+        int x = (std::floor(RayCastLocation.x / GameConfig::kTileSize));
+        int y = (std::floor(RayCastLocation.y / GameConfig::kTileSize));
+        Tile* tempTile = &m_arena->GetTile(y, x);
+        TileType tempType = tempTile->getType();
+        if (tempType == TileType::DestructibleWall || tempType == TileType::FakeDestructibleWall)
+        {
+            tempTile->takeDamage(damage);
+            if (tempTile->getHP() <= 0) {
+                if (tempType == TileType::FakeDestructibleWall) {
+                    // Apply damage to players and destructible tiles in the area around the tile
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        for (int dy = -1; dy <= 1; ++dy) {
+                            int checkX = y + dy;
+                            int checkY = x + dx;
+
+                            for (auto& [playerId, player] : *m_players) {
+                                // Check if the player's position overlaps with the tile's surrounding area
+                                if ((int)player.GetPosition().y / GameConfig::kTileSize == checkX &&
+                                    (int)player.GetPosition().x / GameConfig::kTileSize == checkY) {
+                                    // Apply damage to the player
+                                    player.Damage(40);
                                 }
                             }
+
+                            Tile* surroundingTile = &m_arena->GetTile(checkX, checkY);
+                            if (surroundingTile->getType() == TileType::FakeDestructibleWall || surroundingTile->getType() == TileType::DestructibleWall)
+                            {
+                                surroundingTile->takeDamage(30);
+                                m_mapChanges.Append(m_tickIndex, { checkY, checkX }, static_cast<uint8_t>(surroundingTile->getType()));
+                            }
                         }
-                        m_mapChanges.push_back({ x, y });
-                        player.m_weapon.deactivateBullet(i);
-                    }
-                    else {
-                        player.m_weapon.deactivateBullet(i);
-                    }
-                }
-                else {
-                    if (tempTile->getType() == TileType::IndestructibleWall) {
-                        player.m_weapon.deactivateBullet(i);
-                    }
-                    else {
-                        ++i;
                     }
                 }
+                m_mapChanges.Append(m_tickIndex, { x, y }, static_cast<uint8_t>(tempTile->getType()));
             }
+            m_bullets.Deactivate(i);
+        }
+        else if (tempType == TileType::IndestructibleWall) {
+            m_bullets.Deactivate(i);
+        }
+        else {
+            ++i;
         }
     }
 }
 
-crow::json::wvalue GameState::ToJson() const {
-    crow::json::wvalue gameStateJson;
+std::string GameState::ArenaToBinary(bool seeded) const {
+    return m_arena->ToBinary(seeded);
+}
 
-    // Serialize players (this includes their bullets)
-    crow::json::wvalue playersJson = crow::json::wvalue::list();
-    size_t playerIndex = 0;
-    for (const auto& [playerId, player] : *m_players) {
-        playersJson[playerIndex++] = player.ToJson();
+bool GameState::ArenaDeltaToBinary(uint64_t since, std::string& out) const {
+    std::vector<MapChange> changes;
+    ArenaDelta delta;
+    delta.since = since;
+    if (!m_mapChanges.CopySince(since, changes, delta.version)) {
+        return false;
     }
-    gameStateJson["players"] = std::move(playersJson);
 
-    // Serialize map changes
-    gameStateJson["mapChanges"] = MapChangesToJson();
-    m_mapChanges.clear();
+    // A tile can change many times, the client only needs where it ended up
+    std::set<MapPosition> seen;
+    for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
+        if (seen.insert(it->position).second) {
+            delta.changes.push_back({ it->position.first, it->position.second, it->type });
+        }
+    }
+    std::reverse(delta.changes.begin(), delta.changes.end());
+    out = ArenaCodec::EncodeDelta(delta);
+    return true;
+}
 
-    // Serialize game status
-    gameStateJson["isGameOver"] = IsGameOver();
+void GameState::StartRecording(std::shared_ptr<ReplayRecorder> recorder)
+{
+    m_recorder = std::move(recorder);
+    m_recorder->RecordArena(m_arena->ToBinary(true));
 
-    return gameStateJson;
+    // In id order, the same order the ticks visit them in
+    for (const auto& [playerId, player] : *m_players) {
+        m_recorder->RecordPlayer(playerId, player.GetMonkeyType(), player.GetPosition(), player.GetName());
+        m_recorder->RecordResolution(playerId, player.GetScreenWidth(), player.GetScreenHeight());
+    }
 }
 
-crow::json::wvalue GameState::MapChangesToJson() const
+void GameState::StopRecording()
 {
-    crow::json::wvalue changes = crow::json::wvalue::list();
-    size_t index = 0;
-    for (const auto& [x, y] : m_mapChanges) {
-        changes[index]["x"] = x;
-        changes[index]["y"] = y;
-        ++index;
+    if (m_recorder) {
+        m_recorder->Finish(StateHash());
     }
-    return changes;
 }
 
-crow::json::wvalue GameState::ArenaToJson() const {
-    crow::json::wvalue arenaData;
-    arenaData["arena"] = m_arena->ToJson();
-    return arenaData;
+uint64_t GameState::StateHash() const
+{
+    // FNV-1a over everything the simulation changes
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (const auto& [playerId, player] : *m_players) {
+        mix(static_cast<uint64_t>(playerId));
+        mix(std::bit_cast<uint32_t>(player.GetPosition().x));
+        mix(std::bit_cast<uint32_t>(player.GetPosition().y));
+        mix(static_cast<uint64_t>(player.GetCharacter()->GetHealth()));
+    }
+
+    mix(m_bullets.Size());
+    for (size_t i = 0; i < m_bullets.Size(); ++i) {
+        mix(static_cast<uint64_t>(m_bullets.GetOwner(i)));
+        mix(std::bit_cast<uint32_t>(m_bullets.GetPosition(i).x));
+        mix(std::bit_cast<uint32_t>(m_bullets.GetPosition(i).y));
+    }
+
+    for (const auto& change : m_arena->ToSeededSnapshot().changes) {
+        mix(static_cast<uint64_t>(change.x) << 32 | static_cast<uint32_t>(change.y));
+        mix(change.type);
+    }
+    return hash;
 }
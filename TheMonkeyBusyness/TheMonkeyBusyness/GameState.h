@@ -1,4 +1,5 @@
 #pragma once
+#include <map>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -6,13 +7,22 @@
 #include "Player.h"
 #include "Arena.h"
 #include "Raycast.h"
+#include "BulletPool.h"
+#include "InputQueue.h"
+#include "ReplayRecorder.h"
+#include "SnapshotWriter.h"
+#include "FrameAllocator.h"
+#include "MapChangeLog.h"
+#include <memory_resource>
 #include <chrono>
-#include "crow/json.h"
+#include <cstdint>
+#include "JsonFwd.h"
 
 class GameState
 {
 public:
-    GameState() : m_arena(std::make_shared<Arena>()), m_players(std::make_shared<std::unordered_map<int, Player>>()) {}
+    GameState() : GameState(std::make_shared<Arena>()) {}
+    explicit GameState(std::shared_ptr<Arena> arena) : m_players(std::make_shared<std::map<int, Player>>()), m_arena(std::move(arena)) {}
     GameState(const GameState&) = delete;
     GameState& operator=(const GameState&) = delete;
     GameState(GameState&&) = default;
@@ -21,29 +31,66 @@ public:
     // Game Lifecycle
     bool IsGameOver() const;
     // Player Management
-    void AddPlayer(int playerId);
+    void AddPlayer(int playerId, const std::string& name = PlayerConfig::kUnknownPlayerName); // At a free spawn
+    void AddPlayer(const Player& player); // Takes the player as is, replays restore recorded players with it
     void RemovePlayer(int playerId);
     Player* GetPlayer(int playerId);
-    Player InitializePlayer(int playerId);
-    std::string GetPlayerNameFromDatabase(int playerId);
+    Player InitializePlayer(int playerId, const std::string& playerName);
 
     // Updates
     void ProcessMove(int playerId, const Vector2<float>& movement, const Vector2<float>& lookDirection, float deltaTime);
     void ProcessShoot(int playerId, const Vector2<float>& mousePosition);
+    std::shared_ptr<InputQueue> GetInputQueue(int playerId); // Created with the player, nullptr for unknown ids
     void SpecialAbility(int playerId);
-    void UpdateGame(float deltaTime);
+    void UpdateGame(float deltaTime); // Applies every player's queued input once, then steps the world
+    // Timing, every game keeps its own and only its loop thread advances it
+    void Tick();                     // UpdateGame by one fixed step and counts it
+    float GetDeltaTime() const;      // Seconds per tick, GameConfig::kFixedDeltaTime
+    uint64_t GetTickIndex() const;   // Ticks run so far
+    double GetSimulatedTime() const; // Seconds of play so far
     void SetResolution(int width, int height, int playerId);
+    size_t GetBulletCount() const;
     // Serialization
-    crow::json::wvalue ToJson() const;
-    crow::json::wvalue MapChangesToJson() const;
+    crow::json::wvalue ToJson() const; // Every player, bullet and map change
+    // Snapshot JSON for one client: players and bullets near its screen in full, far players only
+    // as a coarse position and only when includeFar is set. Written into the game's own buffer,
+    // valid until the next call, allocation free once the buffer has grown.
+    // mapCursor is the client's position in the map change log, moved past the changes written.
+    // A cursor older than the log gets "arenaResync" instead, the client then asks /game_arena_delta.
+    const std::string& WriteSnapshot(int viewerId, bool includeFar, uint64_t& mapCursor);
+    const MapChangeLog& GetMapChanges() const;
+    uint64_t GetArenaVersion() const; // Map changes so far, safe from any thread
+    uint64_t NextSnapshotIndex(); // Counts per-client snapshot rounds, paces the far updates
+    crow::json::wvalue MapChangesToJson() const; // The whole change log
     crow::json::wvalue ArenaToJson() const;
+    std::string ArenaToBinary(bool seeded) const;
+    // ArenaCodec delta of the tiles changed after version since, false when the log no longer has them
+    bool ArenaDeltaToBinary(uint64_t since, std::string& out) const;
+    // Replays
+    void StartRecording(std::shared_ptr<ReplayRecorder> recorder); // Records the arena and the players already added
+    void StopRecording();                                          // Ends the replay with StateHash()
+    uint64_t StateHash() const; // Players, bullets and changed tiles, equal for equal simulations
 
 private:
-    std::shared_ptr<std::unordered_map<int, Player>> m_players;
-    mutable std::vector<MapPosition> m_mapChanges;
+    // Ordered by id: ticks visit players in this order, so a replay that adds them in another order still matches
+    std::shared_ptr<std::map<int, Player>> m_players;
+    MapChangeLog m_mapChanges;
     std::shared_ptr<Arena> m_arena;
+    std::unordered_map<int, std::shared_ptr<InputQueue>> m_inputQueues;
     Cast m_raycast;
+    BulletPool m_bullets; // Bullets of every player, tagged with the owner's id
+    FrameAllocator m_frame; // Scratch memory of the running tick, for std::pmr containers inside UpdateGame
+    uint64_t m_snapshotIndex = 0;
+    SnapshotWriter m_snapshotWriter;
+    std::vector<size_t> m_visibleBullets; // Scratch list for WriteSnapshot
+    float m_deltaTime = GameConfig::kFixedDeltaTime;
+    uint64_t m_tickIndex = 0;
+    double m_simulatedTime = 0.0;
+    std::shared_ptr<ReplayRecorder> m_recorder; // Set before the game starts, kept after StopRecording
 
 private:
     void UpdateBullets(float deltaTime);
+    void Step(float deltaTime); // UpdateGame without the rewind, everything it allocates from m_frame is gone when it returns
+    void TakeInputs(float deltaTime, std::pmr::vector<std::pair<int, PlayerInput>>& inputs); // Also applies pending resolutions
+    void ApplyInput(int playerId, const PlayerInput& input, float deltaTime);
 };
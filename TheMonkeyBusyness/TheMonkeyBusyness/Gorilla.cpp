@@ -6,14 +6,11 @@ Gorilla::Gorilla()
 
 void Gorilla::ActivateSpecialAbility() 
 {   //Protection
-    auto now = std::chrono::steady_clock::now();
     if (m_remainingCooldown <= 0) {
         std::cout << "Gorilla activates Shield!\n";
 
         // Activăm scutul de 30 de puncte
         m_HP += 50;
-       
-        m_abilityStartTime = now;
 
         std::cout << "Gorilla ate a banana, +50 hp points!\n";
 
@@ -21,8 +18,6 @@ void Gorilla::ActivateSpecialAbility()
         m_remainingCooldown = m_cooldownTime;
     }
     else {
-        std::chrono::duration<float> elapsed = now - m_abilityStartTime;
-        m_remainingCooldown = m_cooldownTime - elapsed.count();
         std::cout << "Ability is on cooldown. Time left: " << m_remainingCooldown << " seconds\n";
     }
 }
@@ -1,8 +1,7 @@
 #pragma once
-//#include "Character.h"
 #include <chrono>
 #include <iostream>
-import CharacterModule;
+#include "Character.h"
 class Gorilla : public Character
 {
 public:
@@ -10,6 +9,5 @@ public:
 	void ActivateSpecialAbility() override;
 	~Gorilla() = default;
 private:
-	std::chrono::steady_clock::time_point m_abilityStartTime;
 };
 
@@ -0,0 +1,246 @@
+#include "InputCodec.h"
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+enum class Field {
+    Unknown,
+    Type,
+    PlayerId,
+    GameId,
+    DeltaX,
+    DeltaY,
+    MouseX,
+    MouseY,
+    IsShooting,
+    IsSpecialAbility,
+    Width,
+    Height,
+    ArenaVersion,
+    Token,
+    Received
+};
+
+Field FieldFromKey(std::string_view key)
+{
+    // Input keys first, they make up nearly all the traffic
+    if (key == "deltaX") return Field::DeltaX;
+    if (key == "deltaY") return Field::DeltaY;
+    if (key == "mouseX") return Field::MouseX;
+    if (key == "mouseY") return Field::MouseY;
+    if (key == "is_shooting") return Field::IsShooting;
+    if (key == "is_specialAblity") return Field::IsSpecialAbility;
+    if (key == "received") return Field::Received;
+    if (key == "width") return Field::Width;
+    if (key == "height") return Field::Height;
+    if (key == "playerId") return Field::PlayerId;
+    if (key == "gameId") return Field::GameId;
+    if (key == "type") return Field::Type;
+    if (key == "arenaVersion") return Field::ArenaVersion;
+    if (key == "token") return Field::Token;
+    return Field::Unknown;
+}
+
+class Scanner
+{
+public:
+    explicit Scanner(std::string_view data) : m_data{ data } {}
+
+    void SkipSpace()
+    {
+        while (m_pos < m_data.size() && (m_data[m_pos] == ' ' || m_data[m_pos] == '\t' || m_data[m_pos] == '\n' || m_data[m_pos] == '\r')) {
+            ++m_pos;
+        }
+    }
+
+    bool Consume(char c)
+    {
+        SkipSpace();
+        if (m_pos < m_data.size() && m_data[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool Peek(char c)
+    {
+        SkipSpace();
+        return m_pos < m_data.size() && m_data[m_pos] == c;
+    }
+
+    // View into the message, escapes aren't part of the schema
+    bool String(std::string_view& value)
+    {
+        if (!Consume('"')) {
+            return false;
+        }
+        size_t start = m_pos;
+        while (m_pos < m_data.size() && m_data[m_pos] != '"') {
+            if (m_data[m_pos] == '\\') {
+                return false;
+            }
+            ++m_pos;
+        }
+        if (m_pos == m_data.size()) {
+            return false;
+        }
+        value = m_data.substr(start, m_pos - start);
+        ++m_pos;
+        return true;
+    }
+
+    // Finite numbers only, from_chars would also take nan and inf which JSON doesn't have
+    bool Number(double& value)
+    {
+        SkipSpace();
+        const char* first = m_data.data() + m_pos;
+        const char* last = m_data.data() + m_data.size();
+        auto [end, error] = std::from_chars(first, last, value);
+        if (error != std::errc() || end == first || !std::isfinite(value)) {
+            return false;
+        }
+        m_pos += end - first;
+        return true;
+    }
+
+    // true/false/null, so flags can be sent as either a bool or a number
+    bool Flag(bool& value)
+    {
+        SkipSpace();
+        if (Literal("true")) {
+            value = true;
+            return true;
+        }
+        if (Literal("false") || Literal("null")) {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    bool AtEnd()
+    {
+        SkipSpace();
+        return m_pos == m_data.size();
+    }
+
+private:
+    std::string_view m_data;
+    size_t m_pos = 0;
+
+    bool Literal(std::string_view word)
+    {
+        if (m_data.substr(m_pos, word.size()) != word) {
+            return false;
+        }
+        m_pos += word.size();
+        return true;
+    }
+};
+
+// The casts below are undefined for values out of the target's range, a client can send anything
+bool ToFloat(double value, float& out)
+{
+    if (std::fabs(value) > std::numeric_limits<float>::max()) {
+        return false;
+    }
+    out = static_cast<float>(value);
+    return true;
+}
+
+bool ToInt(double value, int& out)
+{
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+        return false;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
+
+bool ToCount(double value, uint64_t& out)
+{
+    if (value < 0 || value >= 18446744073709551616.0) { // 2^64
+        return false;
+    }
+    out = static_cast<uint64_t>(value);
+    return true;
+}
+
+}
+
+bool InputCodec::Decode(std::string_view data, InputMessage& message)
+{
+    message = InputMessage();
+    Scanner scanner(data);
+    if (!scanner.Consume('{')) {
+        return false;
+    }
+
+    bool hasPlayerId = false, hasGameId = false, hasWidth = false, hasHeight = false;
+    bool first = true;
+    while (!scanner.Consume('}')) {
+        if (!first && !scanner.Consume(',')) {
+            return false;
+        }
+        first = false;
+
+        std::string_view key;
+        if (!scanner.String(key) || !scanner.Consume(':')) {
+            return false;
+        }
+        Field field = FieldFromKey(key);
+
+        if (scanner.Peek('"')) {
+            std::string_view text;
+            if (!scanner.String(text)) {
+                return false;
+            }
+            if (field == Field::Type) {
+                message.isJoin = text == "join";
+                message.isResume = text == "resume";
+            }
+            else if (field == Field::Token) {
+                message.token = text;
+            }
+            continue;
+        }
+
+        bool isFlag = field == Field::IsShooting || field == Field::IsSpecialAbility;
+        bool flag;
+        if (isFlag && scanner.Flag(flag)) {
+            (field == Field::IsShooting ? message.input.isShooting : message.input.isSpecialAbility) = flag;
+            continue;
+        }
+
+        double value;
+        if (!scanner.Number(value)) {
+            return false;
+        }
+        bool inRange = true;
+        switch (field) {
+        case Field::DeltaX: inRange = ToFloat(value, message.input.movement.x); break;
+        case Field::DeltaY: inRange = ToFloat(value, message.input.movement.y); break;
+        case Field::MouseX: inRange = ToFloat(value, message.input.mousePosition.x); break;
+        case Field::MouseY: inRange = ToFloat(value, message.input.mousePosition.y); break;
+        case Field::IsShooting: message.input.isShooting = value == 1.0; break;
+        case Field::IsSpecialAbility: message.input.isSpecialAbility = value == 1.0; break;
+        case Field::Width: inRange = ToInt(value, message.width); hasWidth = true; break;
+        case Field::Height: inRange = ToInt(value, message.height); hasHeight = true; break;
+        case Field::PlayerId: inRange = ToInt(value, message.playerId); hasPlayerId = true; break;
+        case Field::GameId: inRange = ToInt(value, message.gameId); hasGameId = true; break;
+        case Field::ArenaVersion: inRange = ToCount(value, message.arenaVersion); break;
+        case Field::Received: inRange = ToCount(value, message.received); message.hasReceived = true; break;
+        default: break;
+        }
+        if (!inRange) {
+            return false;
+        }
+    }
+
+    message.hasIds = hasPlayerId && hasGameId;
+    message.hasResolution = hasWidth && hasHeight;
+    return scanner.AtEnd();
+}
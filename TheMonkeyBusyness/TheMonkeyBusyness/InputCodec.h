@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "InputQueue.h"
+
+// Game WebSocket messages from the client, read without building a JSON tree.
+// Kept free of crow, the only JSON it knows is this flat object:
+//   {"type":"join","playerId":..,"gameId":..,"width":..,"height":..[,"arenaVersion":..]} -- first message of a connection
+//   {"type":"resume","token":"..","width":..,"height":..,"arenaVersion":..}     -- or this one after a dropped connection
+//   {"deltaX":..,"deltaY":..,"mouseX":..,"mouseY":..,"is_shooting":0|1,"is_specialAblity":0|1
+//    [,"width":..,"height":..] [,"received":..] [,"playerId":..,"gameId":..]}   -- input, ids only from older clients
+// received is how many messages the client got on this connection so far, the server paces sends by it.
+// Keys can come in any order, unknown keys with a number or string value are skipped. Numbers have to be
+// finite and fit the field, true/false/null are only taken for the two flags.
+
+struct InputMessage {
+    PlayerInput input;
+    bool isJoin = false;
+    bool isResume = false;
+    bool hasIds = false;        // Both playerId and gameId were sent
+    bool hasResolution = false; // Both width and height were sent
+    bool hasReceived = false;
+    int playerId = 0;
+    int gameId = 0;
+    int width = 0;
+    int height = 0;
+    uint64_t arenaVersion = 0;  // Last map change the client applied, 0 when it has none
+    uint64_t received = 0;      // Messages the client got on this connection
+    std::string_view token;     // Resume token, points into the decoded text
+};
+
+namespace InputCodec {
+    // One pass over the text, no heap allocation. False on anything outside the schema (nested values,
+    // escaped strings, nan/inf or out of range numbers, trailing garbage), message is then unspecified.
+    bool Decode(std::string_view data, InputMessage& message);
+}
@@ -0,0 +1,53 @@
+#include "InputQueue.h"
+
+void InputQueue::Push(const PlayerInput& input)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool wasShooting = m_hasInput && m_latest.isShooting;
+    bool wasSpecialAbility = m_hasInput && m_latest.isSpecialAbility;
+    m_latest = input;
+    m_latest.isShooting = input.isShooting || wasShooting;
+    m_latest.isSpecialAbility = input.isSpecialAbility || wasSpecialAbility;
+    m_hasInput = true;
+    m_everPushed = true;
+}
+
+void InputQueue::PushResolution(int width, int height)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_width = width;
+    m_height = height;
+    m_hasResolution = true;
+}
+
+bool InputQueue::Take(PlayerInput& input, bool* isFresh)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (isFresh) {
+        *isFresh = m_hasInput;
+    }
+    m_idleTicks = m_hasInput ? 0 : m_idleTicks + 1;
+    m_hasInput = false;
+    if (!m_everPushed || m_idleTicks >= NetworkConfig::kInputHoldTicks) {
+        // A client that went quiet stops instead of running on its last key press
+        return false;
+    }
+
+    input = m_latest;
+    // Presses count once, the held movement repeats every tick
+    m_latest.isShooting = false;
+    m_latest.isSpecialAbility = false;
+    return true;
+}
+
+bool InputQueue::TakeResolution(int& width, int& height)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_hasResolution) {
+        return false;
+    }
+    width = m_width;
+    height = m_height;
+    m_hasResolution = false;
+    return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <mutex>
+#include "ConstantValues.h"
+#include "Vector2.h"
+
+// One input message from a client, already decoded
+struct PlayerInput {
+    Vector2<float> movement;
+    Vector2<float> mousePosition;
+    bool isShooting = false;
+    bool isSpecialAbility = false;
+};
+
+// Input of one player between ticks. WebSocket threads push as messages arrive, the game's tick
+// takes it once per tick, so sending faster doesn't move a player faster.
+// Movement and aim keep only the latest value and are held until the next message,
+// shooting and the special ability are latched so a press between two ticks isn't lost.
+class InputQueue
+{
+public:
+    void Push(const PlayerInput& input);
+    void PushResolution(int width, int height);
+
+    // Input for this tick. False when there is nothing to apply: no input yet, or none for
+    // NetworkConfig::kInputHoldTicks ticks. isFresh tells whether a message arrived since the last Take.
+    bool Take(PlayerInput& input, bool* isFresh = nullptr);
+    bool TakeResolution(int& width, int& height); // False when unchanged since the last call
+
+private:
+    PlayerInput m_latest;
+    bool m_hasInput = false;    // Pushed since the last Take
+    bool m_everPushed = false;
+    int m_idleTicks = 0;        // Takes since the last push
+    int m_width = 0;
+    int m_height = 0;
+    bool m_hasResolution = false;
+    std::mutex m_mutex;
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+// Simulation headers only need the name of the JSON type. The ToJson bodies live in
+// JsonSerialization.cpp so the simulation library builds and links without Crow.
+namespace crow {
+namespace json {
+class wvalue;
+}
+}
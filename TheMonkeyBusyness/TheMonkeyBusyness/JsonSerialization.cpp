@@ -0,0 +1,112 @@
+#include <crow.h>
+#include "GameState.h"
+#include "Tile.h"
+
+namespace {
+
+crow::json::wvalue ChangesToJson(std::span<const MapChange> changes) {
+    crow::json::wvalue changesJson = crow::json::wvalue::list();
+    size_t index = 0;
+    for (const auto& change : changes) {
+        changesJson[index]["x"] = change.position.first;
+        changesJson[index]["y"] = change.position.second;
+        ++index;
+    }
+    return changesJson;
+}
+
+}
+
+crow::json::wvalue Arena::ToJson() const {
+    crow::json::wvalue arenaJson = crow::json::wvalue::list();
+
+    for (int i = 0; i < m_dim; i++) {  // Iterate through rows
+        crow::json::wvalue jsonRow = crow::json::wvalue::list();
+        for (int j = 0; j < m_dim; j++) {  // Iterate through columns
+            jsonRow[j] = static_cast<int>(m_mapa[i][j].getType());
+        }
+        arenaJson[i] = std::move(jsonRow);
+    }
+
+    return arenaJson;
+}
+
+crow::json::wvalue Tile::ToJson() const {
+	crow::json::wvalue tileJson;
+	tileJson["type"] = static_cast<int>(m_tileType);
+	tileJson["hp"] = m_hp;
+	tileJson["occupied"] = m_playerOccupied;
+	return tileJson;
+}
+
+crow::json::wvalue BulletPool::ToJson(size_t index) const
+{
+	crow::json::wvalue bulletJson;
+	bulletJson["x"] = m_positionX[index];
+	bulletJson["y"] = m_positionY[index];
+	bulletJson["directionX"] = m_directionX[index];
+	bulletJson["directionY"] = m_directionY[index];
+	return bulletJson;
+}
+
+crow::json::wvalue Player::ToJson() const
+{
+	crow::json::wvalue playerJson;
+	playerJson["id"] = m_id;
+	playerJson["name"] = m_name;
+	playerJson["x"] = m_position.x;
+	playerJson["y"] = m_position.y;
+	playerJson["directionX"] = m_direction.x;
+	playerJson["directionY"] = m_direction.y;
+	playerJson["hp"] = m_Character->GetHealth();
+	playerJson["monkeyType"] = m_monkeyType;
+	playerJson["isAlive"] = m_isAlive;
+
+	return playerJson;
+}
+
+crow::json::wvalue GameState::ToJson() const {
+    crow::json::wvalue gameStateJson;
+
+    // Serialize players (this includes their bullets)
+    crow::json::wvalue playersJson = crow::json::wvalue::list();
+    // Bullets live in one game-wide buffer, group them back under their owner's weapon
+    std::unordered_map<int, crow::json::wvalue> bulletsByOwner;
+    for (const auto& [playerId, player] : *m_players) {
+        bulletsByOwner[playerId] = crow::json::wvalue::list();
+    }
+    std::unordered_map<int, size_t> bulletCounts;
+    for (size_t i = 0; i < m_bullets.Size(); ++i) {
+        int ownerId = m_bullets.GetOwner(i);
+        if (auto it = bulletsByOwner.find(ownerId); it != bulletsByOwner.end()) {
+            it->second[bulletCounts[ownerId]++] = m_bullets.ToJson(i);
+        }
+    }
+
+    size_t playerIndex = 0;
+    for (const auto& [playerId, player] : *m_players) {
+        crow::json::wvalue playerJson = player.ToJson();
+        playerJson["weapon"]["bullets"] = std::move(bulletsByOwner[playerId]);
+        playersJson[playerIndex++] = std::move(playerJson);
+    }
+    gameStateJson["players"] = std::move(playersJson);
+
+    // Serialize map changes
+    gameStateJson["mapChanges"] = MapChangesToJson();
+
+    // Serialize game status
+    gameStateJson["isGameOver"] = IsGameOver();
+
+    return gameStateJson;
+}
+
+crow::json::wvalue GameState::MapChangesToJson() const
+{
+    return ChangesToJson(m_mapChanges.Since(0));
+}
+
+crow::json::wvalue GameState::ArenaToJson() const {
+    crow::json::wvalue arenaData;
+    arenaData["arena"] = m_arena->ToJson();
+    return arenaData;
+}
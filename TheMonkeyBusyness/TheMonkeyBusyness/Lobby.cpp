@@ -2,16 +2,21 @@
 #include <stdexcept>
 #include "ConstantValues.h"
 #include "iostream"
-Lobby::Lobby(int lobbyId, int hostId)
+Lobby::Lobby(int lobbyId, int hostId, std::string hostResumeToken)
     : m_lobbyId(lobbyId), m_hostId(hostId) {
     m_players[hostId] = false; // Host is initially not ready
+    m_resumeTokens[hostId] = std::move(hostResumeToken);
 }
 
-bool Lobby::AddPlayer(int playerId) {
+bool Lobby::AddPlayer(int playerId, std::string resumeToken) {
     if (HasMaximumPlayers()) {
         return false; // Lobby is full
     }
+    if (m_players.find(playerId) != m_players.end()) {
+        return false; // Joining again would hand out the player's token to whoever asked
+    }
     m_players[playerId] = false;
+    m_resumeTokens[playerId] = std::move(resumeToken);
     return true;
 }
 
@@ -21,6 +26,7 @@ bool Lobby::RemovePlayer(int playerId) {
     }
 
     m_players.erase(playerId);
+    m_resumeTokens.erase(playerId);
 
     // If host leaves, assign a new host
     if (playerId == m_hostId && !m_players.empty()) {
@@ -57,6 +63,15 @@ std::unordered_map<int, bool> Lobby::GetPlayers() const {
     return m_players;
 }
 
+std::string Lobby::GetResumeToken(int playerId) const {
+    auto it = m_resumeTokens.find(playerId);
+    return it != m_resumeTokens.end() ? it->second : std::string();
+}
+
+std::unordered_map<int, std::string> Lobby::GetResumeTokens() const {
+    return m_resumeTokens;
+}
+
 bool Lobby::HasMinimumPlayers() const {
     return m_players.size() >= GameConfig::kMinLobbyPlayers;
 }
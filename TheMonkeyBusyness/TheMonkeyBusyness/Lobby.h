@@ -5,10 +5,11 @@
 
 class Lobby {
 public:
-    explicit Lobby(int lobbyId, int hostId);
+    Lobby(int lobbyId, int hostId, std::string hostResumeToken);
 
     // Player Management
-    bool AddPlayer(int playerId);
+    // False when full or already in. The token is the player's, only ever returned to them.
+    bool AddPlayer(int playerId, std::string resumeToken);
     bool RemovePlayer(int playerId);
     void SetReady(int playerId, bool isReady);
     bool IsAllReady() const;
@@ -21,10 +22,13 @@ public:
     int GetLobbyId() const;
     int GetHostId() const;
     std::unordered_map<int, bool> GetPlayers() const;
+    std::string GetResumeToken(int playerId) const; // Empty for players not in the lobby
+    std::unordered_map<int, std::string> GetResumeTokens() const;
 
 private:
     int m_lobbyId;                    
     int m_hostId; 
     std::unordered_map<int, bool> m_players; // Players and their ready status
+    std::unordered_map<int, std::string> m_resumeTokens; // Carried over to the game, see GameManager
 
 };
@@ -5,12 +5,13 @@
 
 LobbyManager::LobbyManager() : m_nextLobbyId(GameConfig::kfirstLobbyId) {}
 
-int LobbyManager::CreateLobby(int hostId) {
+int LobbyManager::CreateLobby(int hostId, std::string& resumeToken) {
     std::lock_guard<std::mutex> lock(m_lobbyMutex);
 
     int lobbyId = m_nextLobbyId++;
 
-    auto lobby = std::make_shared<Lobby>(lobbyId, hostId);
+    resumeToken = NewResumeToken();
+    auto lobby = std::make_shared<Lobby>(lobbyId, hostId, resumeToken);
     m_lobbies.emplace(lobbyId, lobby);
 
     return lobbyId;
@@ -41,7 +42,7 @@ std::shared_ptr<Lobby> LobbyManager::GetLobby(int lobbyId) {
     return nullptr;
 }
 
-bool LobbyManager::AddPlayerToLobby(int lobbyId, int playerId) {
+bool LobbyManager::AddPlayerToLobby(int lobbyId, int playerId, std::string& resumeToken) {
     std::lock_guard<std::mutex> lock(m_lobbyMutex);
 
     auto it = m_lobbies.find(lobbyId);
@@ -49,7 +50,8 @@ bool LobbyManager::AddPlayerToLobby(int lobbyId, int playerId) {
         return false;
     }
 
-    return it->second->AddPlayer(playerId);
+    resumeToken = NewResumeToken();
+    return it->second->AddPlayer(playerId, resumeToken);
 }
 
 bool LobbyManager::RemovePlayerFromLobby(int lobbyId, int playerId) {
@@ -81,3 +83,17 @@ std::vector<int> LobbyManager::GetActiveLobbyIds() const {
 
     return lobbyIds;
 }
+
+std::string LobbyManager::NewResumeToken() {
+    // 128 random bits straight from the OS source, the token is what lets a connection take over a player
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::string token;
+    token.reserve(32);
+    for (int i = 0; i < 4; ++i) {
+        uint32_t bits = m_tokenSource();
+        for (int nibble = 0; nibble < 8; ++nibble) {
+            token += kHex[(bits >> (nibble * 4)) & 0xF];
+        }
+    }
+    return token;
+}
@@ -4,6 +4,8 @@
 #include <unordered_map>
 #include <mutex>
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
 
 class LobbyManager {
@@ -11,12 +13,12 @@ public:
     LobbyManager();
 
     // Lobby Management
-    int CreateLobby(int hostId);
+    int CreateLobby(int hostId, std::string& resumeToken); // resumeToken is the host's, see Lobby::AddPlayer
     bool DeleteLobby(int lobbyId);
     std::shared_ptr<Lobby> GetLobby(int lobbyId);
 
     // Player-Lobby Management
-    bool AddPlayerToLobby(int lobbyId, int playerId);
+    bool AddPlayerToLobby(int lobbyId, int playerId, std::string& resumeToken);
     bool RemovePlayerFromLobby(int lobbyId, int playerId);
 
     // Get list of active lobbies
@@ -26,4 +28,7 @@ private:
     std::unordered_map<int, std::shared_ptr<Lobby>> m_lobbies;
     int m_nextLobbyId;  // For generating unique lobby IDs
     mutable std::mutex m_lobbyMutex;
+    std::random_device m_tokenSource;
+
+    std::string NewResumeToken(); // Caller holds m_lobbyMutex
 };
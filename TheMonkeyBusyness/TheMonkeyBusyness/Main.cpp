@@ -3,6 +3,10 @@
 #include "LobbyManager.h"
 #include <crow/websocket.h>
 #include "UserDatabase.h"
+#include "ConnectionHub.h"
+#include "ClientSession.h"
+#include "InputCodec.h"
+#include <cstdlib>
 #include <unordered_set>
 #include <memory>
 #include <mutex>
@@ -10,8 +14,26 @@
 std::shared_ptr<GameManager> gameManager = std::make_shared<GameManager>();
 std::shared_ptr<LobbyManager> lobbyManager = std::make_shared<LobbyManager>();
 std::shared_ptr<UserDatabase> m_db = std::make_shared<UserDatabase>("userdatabase.db");
+// Outlives the app so late onclose callbacks still find it
+std::shared_ptr<ConnectionHub> connectionHub = std::make_shared<ConnectionHub>();
+
+int main(int argc, char* argv[]) {
+    // --sim-speed N runs every game N times faster than real time, for bots and soak tests
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--sim-speed") {
+            gameManager->SetSimulationSpeed(static_cast<float>(std::atof(argv[++i])));
+        }
+    }
+
+    // Every client gets what is around its own screen, once per tick on the game's loop thread.
+    // Only queues, the hub's sender thread does the actual sends.
+    gameManager->SetTickListener([](int gameId, GameState& gameState) {
+        bool includeFar = gameState.NextSnapshotIndex() % NetworkConfig::kFarUpdateInterval == 0;
+        connectionHub->BroadcastPerPlayer(gameId, [&](int playerId, uint64_t& mapCursor) -> std::string_view {
+            return gameState.WriteSnapshot(playerId, includeFar, mapCursor);
+            });
+        });
 
-int main() {
     crow::SimpleApp app;
 
     CROW_ROUTE(app, "/create_lobby").methods(crow::HTTPMethod::POST)([&](const crow::request& req) {
@@ -22,10 +44,12 @@ int main() {
 
         int hostId = json["hostId"].i();
         std::cout << "Created Lobby with host id " << hostId;
-        int lobbyId = lobbyManager->CreateLobby(hostId);
+        std::string resumeToken;
+        int lobbyId = lobbyManager->CreateLobby(hostId, resumeToken);
 
         crow::json::wvalue response;
         response["lobbyId"] = lobbyId;
+        response["resumeToken"] = resumeToken; // Only ever sent here, to the player it belongs to
         return crow::response(response);
         });
 
@@ -38,8 +62,11 @@ int main() {
         int lobbyId = json["lobbyId"].i();
         int playerId = json["playerId"].i();
 
-        if (lobbyManager->AddPlayerToLobby(lobbyId, playerId)) {
-            return crow::response(200, "Player added to lobby");
+        std::string resumeToken;
+        if (lobbyManager->AddPlayerToLobby(lobbyId, playerId, resumeToken)) {
+            crow::json::wvalue response;
+            response["resumeToken"] = resumeToken; // Only ever sent here, to the player it belongs to
+            return crow::response(response);
         }
         else {
             return crow::response(400, "Failed to join lobby");
@@ -215,6 +242,7 @@ int main() {
 
             crow::json::wvalue response;
             response["gameId"] = gameId;
+            response["resumeToken"] = gameManager->GetResumeToken(gameId, playerId);
             std::cout << "Game started with ID = " << gameId << std::endl;
             return crow::response(response);
         }
@@ -289,83 +317,145 @@ int main() {
             return crow::response(404, "Game not found");
         }
 
-        return crow::response(gameState->ArenaToJson().dump());
+        // Seed + changed tiles by default, clients regenerate the map locally.
+        // format=full sends every tile (RLE), format=json the old nested grid for debugging
+        auto formatParam = req.url_params.get("format");
+        std::string format = formatParam ? formatParam : "seed";
+        if (format == "json") {
+            return crow::response(gameState->ArenaToJson().dump());
+        }
+
+        // Read first, changes landing while encoding are sent again by the delta or the snapshots
+        uint64_t version = gameState->GetArenaVersion();
+        crow::response response(200, gameState->ArenaToBinary(format != "full"));
+        response.set_header("Content-Type", ArenaCodec::kContentType);
+        response.set_header("X-Arena-Version", std::to_string(version));
+        return response;
+        });
+
+    // Tiles changed after arena version since (X-Arena-Version of an earlier answer), for clients that fell behind.
+    // When the game no longer keeps changes that old the answer is the whole seeded arena, ArenaCodec::IsDelta tells which.
+    CROW_ROUTE(app, "/game_arena_delta").methods(crow::HTTPMethod::GET)([&](const crow::request& req) {
+        auto gameIdStr = req.url_params.get("gameId");
+        auto sinceStr = req.url_params.get("since");
+        if (!gameIdStr || !sinceStr) {
+            return crow::response(400, "Missing gameId or since");
+        }
+
+        int gameId = std::atoi(gameIdStr);
+        uint64_t since = std::strtoull(sinceStr, nullptr, 10);
+        auto gameState = gameManager->GetGameState(gameId);
+        if (!gameState) {
+            return crow::response(404, "Game not found");
+        }
+
+        uint64_t version = gameState->GetArenaVersion();
+        std::string body;
+        if (!gameState->ArenaDeltaToBinary(since, body)) {
+            body = gameState->ArenaToBinary(true);
+        }
+        crow::response response(200, std::move(body));
+        response.set_header("Content-Type", ArenaCodec::kContentType);
+        response.set_header("X-Arena-Version", std::to_string(version));
+        return response;
         });
 
     /* Other commented out routes are skipped as per instruction */
 
-    std::unordered_map<crow::websocket::connection*, int> connections;
-    std::mutex gameStateMutex;
-    std::mutex connectionsMutex;
+    // Outgoing queue health: messages the clients haven't confirmed, what waits here, snapshots skipped and clients dropped
+    CROW_ROUTE(app, "/metrics/connections").methods(crow::HTTPMethod::GET)([&]() {
+        ConnectionHub::Metrics metrics = connectionHub->GetMetrics();
+
+        crow::json::wvalue response;
+        response["connections"] = metrics.connections;
+        response["queuedMessages"] = metrics.queuedMessages;
+        response["maxQueueDepth"] = metrics.maxQueueDepth;
+        response["maxQueueAgeMs"] = metrics.maxQueueAgeMs;
+        response["inFlightMessages"] = metrics.inFlightMessages;
+        response["maxInFlight"] = metrics.maxInFlight;
+        response["heldConnections"] = metrics.heldConnections;
+        response["sentMessages"] = metrics.sentMessages;
+        response["replacedSnapshots"] = metrics.replacedSnapshots;
+        response["droppedMessages"] = metrics.droppedMessages;
+        response["shedConnections"] = metrics.shedConnections;
+        response["replacedConnections"] = metrics.replacedConnections;
+        return crow::response(response);
+        });
+
     CROW_ROUTE(app, "/webSocket")
         .websocket(&app)
         .onopen([&](crow::websocket::connection& conn) {
         std::cout << "WebSocket connection opened!" << std::endl;
             })
         .onmessage([&](crow::websocket::connection& conn, const std::string& data, bool isBinary) {
-        // Handle incoming messages
-        std::lock_guard<std::mutex> lock(gameStateMutex);
-
-        auto json = crow::json::load(data);
-
-        if (!json) {
-            std::cerr << "Invalid JSON received." << std::endl;
+        // Fixed schema, decoded straight into the input without a JSON tree
+        InputMessage message;
+        if (!InputCodec::Decode(data, message)) {
+            std::cerr << "Invalid input message received." << std::endl;
             return;
         }
 
-        int playerId = json["playerId"].i();
-        int gameId = json["gameId"].i();
-        float deltaX = json["deltaX"].d();
-        float deltaY = json["deltaY"].d();
-        float mouseX = json["mouseX"].d();
-        float mouseY = json["mouseY"].d();
-        int is_shooting = json["is_shooting"].i();
-        int width = json["width"].i();
-        int height = json["height"].i();
-        int is_specialAblity = json["is_specialAblity"].i();
-        auto gameState = (gameId != -1) ? gameManager->GetGameState(gameId) : nullptr;
-
-        // Broadcast the message back to all connected clients
-        if (gameState != nullptr)
-        {
-            {
-                std::lock_guard<std::mutex> lock(connectionsMutex); // Lock the connections
-                if (connections.find(&conn) == connections.end()) {
-                    connections[&conn] = gameId;
+        auto* session = static_cast<ClientSession*>(conn.userdata());
+        if (!session) {
+            // First message binds the connection: {"type":"join","playerId":..,"gameId":..,"width":..,"height":..}
+            // Older clients send playerId and gameId with every input, their first input doubles as the join
+            // A dropped client rebinds with {"type":"resume","token":..} and the arena version it already has.
+            // Only the token proves who's asking, so only a resume can take over a player that still has a connection
+            int playerId = message.playerId;
+            int gameId = message.gameId;
+            if (message.isResume) {
+                if (!gameManager->FindResumeToken(std::string(message.token), gameId, playerId)) {
+                    conn.send_text("0");
+                    return;
                 }
             }
-            //std::cout << std::fixed <<gameManager.GetDeltaTime();
-            gameState->SetResolution(width, height, playerId);
-            if (is_shooting == 1) {
-                gameState->ProcessShoot(playerId, Vector2(mouseX, mouseY));
+            else if (!message.hasIds) {
+                conn.send_text("0");
+                return;
             }
-            if (is_specialAblity == 1) {
-                gameState->SpecialAbility(playerId);
+            auto gameState = (gameId != -1) ? gameManager->GetGameState(gameId) : nullptr;
+            auto inputs = gameState ? gameState->GetInputQueue(playerId) : nullptr;
+            if (!inputs) {
+                conn.send_text("0");
+                return;
             }
-            gameState->ProcessMove(playerId, Vector2(deltaX, deltaY), Vector2(mouseX, mouseY), gameManager->GetDeltaTime());
-            auto jsonResponse = gameState->ToJson();
 
-            std::lock_guard<std::mutex> lock(connectionsMutex); // Lock the connections
-            for (auto& [connection, connectionGameId] : connections) {
-                if (gameId == connectionGameId) {
-                    connection->send_text(jsonResponse.dump());
+            // Snapshots carry the changes after arenaVersion, or arenaResync if those were compacted away
+            if (!connectionHub->Register(conn, gameId, playerId, message.arenaVersion, message.isResume)) {
+                conn.send_text("0");
+                return;
+            }
+            session = new ClientSession{ playerId, gameId, std::move(gameState), std::move(inputs) };
+            conn.userdata(session);
+            if (message.isJoin || message.isResume) {
+                if (message.hasResolution) {
+                    session->width = message.width;
+                    session->height = message.height;
+                    session->inputs->PushResolution(session->width, session->height);
                 }
+                return;
             }
+        }
 
+        if (message.hasReceived) {
+            connectionHub->Acknowledge(conn, message.received);
         }
-        else {
-            std::lock_guard<std::mutex> lock(connectionsMutex); // Lock the connections
-            for (auto& [connection, connectionGameId] : connections) {
-                if (gameId == connectionGameId) {
-                    connection->send_text("0");
-                }
-            }
+
+        // Applied by the game's next tick, however fast the client sends
+        session->inputs->Push(message.input);
+
+        // Resolution is only sent when it changes
+        if (message.hasResolution && (message.width != session->width || message.height != session->height)) {
+            session->width = message.width;
+            session->height = message.height;
+            session->inputs->PushResolution(message.width, message.height);
         }
             })
         .onclose([&](crow::websocket::connection& conn, const std::string& reason) {
         std::cout << "WebSocket connection closed: " << reason << std::endl;
-        std::lock_guard<std::mutex> lock(connectionsMutex);
-        connections.erase(&conn);
+        connectionHub->Unregister(conn);
+        delete static_cast<ClientSession*>(conn.userdata());
+        conn.userdata(nullptr);
             });
 
     // Start server
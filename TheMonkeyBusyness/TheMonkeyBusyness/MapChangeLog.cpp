@@ -0,0 +1,66 @@
+#include "MapChangeLog.h"
+
+void MapChangeLog::Append(uint64_t tick, const MapPosition& position, uint8_t type)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_changes.push_back({ tick, position, type });
+}
+
+void MapChangeLog::Compact(size_t keep)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_changes.size() <= keep) {
+        return;
+    }
+    size_t dropped = m_changes.size() - keep;
+    m_changes.erase(m_changes.begin(), m_changes.begin() + dropped);
+    m_firstVersion += dropped;
+}
+
+uint64_t MapChangeLog::GetVersion() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_firstVersion + m_changes.size();
+}
+
+uint64_t MapChangeLog::GetFirstVersion() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_firstVersion;
+}
+
+bool MapChangeLog::IsCompacted(uint64_t cursor) const
+{
+    return cursor < GetFirstVersion();
+}
+
+size_t MapChangeLog::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_changes.size();
+}
+
+std::span<const MapChange> MapChangeLog::Since(uint64_t cursor) const
+{
+    if (cursor < m_firstVersion) {
+        cursor = m_firstVersion;
+    }
+    if (cursor >= m_firstVersion + m_changes.size()) {
+        return {};
+    }
+    return std::span<const MapChange>(m_changes).subspan(static_cast<size_t>(cursor - m_firstVersion));
+}
+
+bool MapChangeLog::CopySince(uint64_t since, std::vector<MapChange>& changes, uint64_t& version) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    version = m_firstVersion + m_changes.size();
+    if (since < m_firstVersion) {
+        return false;
+    }
+    changes.clear();
+    if (since < version) {
+        changes.assign(m_changes.begin() + static_cast<size_t>(since - m_firstVersion), m_changes.end());
+    }
+    return true;
+}
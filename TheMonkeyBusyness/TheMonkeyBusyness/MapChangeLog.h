@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "ConstantValues.h"
+
+struct MapChange {
+    uint64_t tick; // GameState tick the tile changed on
+    MapPosition position;
+    uint8_t type;  // Tile type right after the change
+};
+
+// Every tile change of one game, in order. The number of changes so far is the arena's version,
+// readers keep their own cursor (the version they have seen), so any number of clients can follow
+// the same log and each gets every change exactly once. Compact() drops the oldest changes,
+// a reader whose cursor falls before them has to resync from the whole arena.
+// Only the game's loop thread changes the log. It may read without the lock, other threads use the
+// locked calls.
+class MapChangeLog
+{
+public:
+    void Append(uint64_t tick, const MapPosition& position, uint8_t type);
+    void Compact(size_t keep); // Keeps the newest keep changes
+
+    uint64_t GetVersion() const;      // Changes so far, the cursor of a reader that saw everything
+    uint64_t GetFirstVersion() const; // Cursor of the oldest change still kept
+    bool IsCompacted(uint64_t cursor) const; // Changes after cursor were dropped
+    size_t Size() const;
+    std::span<const MapChange> Since(uint64_t cursor) const; // Loop thread only, what a reader at cursor hasn't seen and is still kept
+
+    // Locked: the changes after since, false when some were already compacted away
+    bool CopySince(uint64_t since, std::vector<MapChange>& changes, uint64_t& version) const;
+
+private:
+    std::vector<MapChange> m_changes;
+    uint64_t m_firstVersion = 0;
+    mutable std::mutex m_mutex;
+};
@@ -0,0 +1,39 @@
+#include "MotionKernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MOTION_KERNELS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MOTION_KERNELS_SSE2
+#endif
+
+namespace {
+    // values[i] += direction[i] * speed[i] * dt
+    void ScaledAxpy(float* values, const float* direction, const float* speed, float dt, size_t n)
+    {
+        size_t i = 0;
+#if defined(MOTION_KERNELS_AVX2)
+        const __m256 dtVec = _mm256_set1_ps(dt);
+        for (; i + 8 <= n; i += 8) {
+            __m256 velocity = _mm256_mul_ps(_mm256_loadu_ps(direction + i), _mm256_loadu_ps(speed + i));
+            _mm256_storeu_ps(values + i, _mm256_add_ps(_mm256_loadu_ps(values + i), _mm256_mul_ps(velocity, dtVec)));
+        }
+#elif defined(MOTION_KERNELS_SSE2)
+        const __m128 dtVec = _mm_set1_ps(dt);
+        for (; i + 4 <= n; i += 4) {
+            __m128 velocity = _mm_mul_ps(_mm_loadu_ps(direction + i), _mm_loadu_ps(speed + i));
+            _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), _mm_mul_ps(velocity, dtVec)));
+        }
+#endif
+        for (; i < n; ++i) {
+            values[i] += direction[i] * speed[i] * dt;
+        }
+    }
+}
+
+void MotionKernels::IntegrateDirections(float* xs, float* ys, const float* dirX, const float* dirY, const float* speed, float dt, size_t n)
+{
+    ScaledAxpy(xs, dirX, speed, dt, n);
+    ScaledAxpy(ys, dirY, speed, dt, n);
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <cstddef>
+
+// Batch integration over structure-of-arrays data. Every path (AVX2, SSE2, scalar) does the
+// same float operations in the same order per element, so results do not depend on the CPU.
+namespace MotionKernels {
+    // xs[i] += dirX[i] * speed[i] * dt, ys[i] += dirY[i] * speed[i] * dt
+    void IntegrateDirections(float* xs, float* ys, const float* dirX, const float* dirY, const float* speed, float dt, size_t n);
+}
@@ -0,0 +1,174 @@
+#include "NoiseGrid.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NOISE_GRID_SSE2
+#endif
+
+namespace {
+    // Mirrors FastNoiseLite's private OpenSimplex2 2D constants, the expressions are kept
+    // identical so the values round exactly the same
+    const float kSqrt3 = 1.7320508075688772935274463415059f;
+    const float kF2 = 0.5f * ((float)1.7320508075688772935274463415059 - 1);
+    const float kG2 = (3 - kSqrt3) / 6;
+    const float kCornerT = (float)(2 * (1 - 2 * kG2) * (1 / kG2 - 2));
+    const float kCornerA = (float)(-2 * (1 - 2 * kG2) * (1 - 2 * kG2));
+    const float kScale = 99.83685446303647f;
+    constexpr int kPrimeX = 501125321;
+    constexpr int kPrimeY = 1136930381;
+    constexpr int kHashMultiplier = 0x27d4eb2d;
+
+#ifdef NOISE_GRID_SSE2
+    // Copy of FastNoiseLite::Lookup<float>::Gradients2D, which is private
+    alignas(16) const float kGradients2D[256] =
+    {
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.38268343236509f, 0.923879532511287f, 0.923879532511287f, 0.38268343236509f, 0.923879532511287f, -0.38268343236509f, 0.38268343236509f, -0.923879532511287f,
+        -0.38268343236509f, -0.923879532511287f, -0.923879532511287f, -0.38268343236509f, -0.923879532511287f, 0.38268343236509f, -0.38268343236509f, 0.923879532511287f,
+    };
+
+    // Low 32 bits of a 32x32 multiply per lane, SSE2 has no _mm_mullo_epi32
+    __m128i MulLo(__m128i a, __m128i b)
+    {
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    __m128 GradCoord(__m128i seed, __m128i xPrimed, __m128i yPrimed, __m128 xd, __m128 yd)
+    {
+        __m128i hash = _mm_xor_si128(_mm_xor_si128(seed, xPrimed), yPrimed);
+        hash = MulLo(hash, _mm_set1_epi32(kHashMultiplier));
+        hash = _mm_xor_si128(hash, _mm_srai_epi32(hash, 15));
+        hash = _mm_and_si128(hash, _mm_set1_epi32(127 << 1));
+
+        // Each hash picks an (x, y) gradient pair, load the pairs as 64-bit halves and split them
+        alignas(16) int index[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), hash);
+        __m128 pairs01 = _mm_loadh_pi(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(kGradients2D + index[0]))),
+            reinterpret_cast<const __m64*>(kGradients2D + index[1]));
+        __m128 pairs23 = _mm_loadh_pi(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(kGradients2D + index[2]))),
+            reinterpret_cast<const __m64*>(kGradients2D + index[3]));
+        __m128 xg = _mm_shuffle_ps(pairs01, pairs23, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 yg = _mm_shuffle_ps(pairs01, pairs23, _MM_SHUFFLE(3, 1, 3, 1));
+
+        return _mm_add_ps(_mm_mul_ps(xd, xg), _mm_mul_ps(yd, yg));
+    }
+
+    // (v * v) * (v * v) * grad where v > 0, zero elsewhere
+    __m128 Contribution(__m128 v, __m128 grad)
+    {
+        __m128 v2 = _mm_mul_ps(v, v);
+        return _mm_and_ps(_mm_cmpgt_ps(v, _mm_setzero_ps()), _mm_mul_ps(_mm_mul_ps(v2, v2), grad));
+    }
+#endif
+}
+
+NoiseGrid::NoiseGrid(int seed, float frequency) : m_noise{ seed }, m_seed{ seed }, m_frequency{ frequency }
+{
+    m_noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    m_noise.SetFrequency(frequency);
+}
+
+float NoiseGrid::Sample(float x, float y) const
+{
+    return m_noise.GetNoise(x, y);
+}
+
+void NoiseGrid::Fill(int x0, int y0, int width, int height, float* out) const
+{
+    for (int row = 0; row < height; ++row) {
+        FillRow(x0, y0 + row, width, out + static_cast<size_t>(row) * width);
+    }
+}
+
+void NoiseGrid::FillRow(int x0, int y, int width, float* out) const
+{
+    int col = 0;
+#ifdef NOISE_GRID_SSE2
+    const __m128i seed = _mm_set1_epi32(m_seed);
+    const __m128i primeX = _mm_set1_epi32(kPrimeX);
+    const __m128i primeY = _mm_set1_epi32(kPrimeY);
+    const __m128 g2 = _mm_set1_ps(kG2);
+    const __m128 g2MinusOne = _mm_set1_ps(kG2 - 1);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 frequency = _mm_set1_ps(m_frequency);
+    const __m128 rowY = _mm_mul_ps(_mm_set1_ps((float)y), frequency);
+
+    for (; col + 4 <= width; col += 4) {
+        // TransformNoiseCoordinate: frequency and skew
+        __m128i columns = _mm_add_epi32(_mm_set1_epi32(x0 + col), _mm_setr_epi32(0, 1, 2, 3));
+        __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(columns), frequency);
+        __m128 yy = rowY;
+        __m128 skew = _mm_mul_ps(_mm_add_ps(x, yy), _mm_set1_ps(kF2));
+        x = _mm_add_ps(x, skew);
+        yy = _mm_add_ps(yy, skew);
+
+        // FastFloor: truncate, minus one for negative inputs
+        __m128i i = _mm_add_epi32(_mm_cvttps_epi32(x), _mm_castps_si128(_mm_cmplt_ps(x, _mm_setzero_ps())));
+        __m128i j = _mm_add_epi32(_mm_cvttps_epi32(yy), _mm_castps_si128(_mm_cmplt_ps(yy, _mm_setzero_ps())));
+        __m128 xi = _mm_sub_ps(x, _mm_cvtepi32_ps(i));
+        __m128 yi = _mm_sub_ps(yy, _mm_cvtepi32_ps(j));
+
+        __m128 t = _mm_mul_ps(_mm_add_ps(xi, yi), g2);
+        __m128 x0f = _mm_sub_ps(xi, t);
+        __m128 y0f = _mm_sub_ps(yi, t);
+
+        i = MulLo(i, primeX);
+        j = MulLo(j, primeY);
+
+        __m128 a = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x0f, x0f)), _mm_mul_ps(y0f, y0f));
+        __m128 n0 = Contribution(a, GradCoord(seed, i, j, x0f, y0f));
+
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kCornerT), t), _mm_add_ps(_mm_set1_ps(kCornerA), a));
+        __m128 x2 = _mm_add_ps(x0f, _mm_set1_ps(2 * kG2 - 1));
+        __m128 y2 = _mm_add_ps(y0f, _mm_set1_ps(2 * kG2 - 1));
+        __m128 n2 = Contribution(c, GradCoord(seed, _mm_add_epi32(i, primeX), _mm_add_epi32(j, primeY), x2, y2));
+
+        // Middle corner is (0, 1) above the diagonal and (1, 0) below it
+        __m128 upper = _mm_cmpgt_ps(y0f, x0f);
+        __m128i upperInt = _mm_castps_si128(upper);
+        __m128 x1 = _mm_add_ps(x0f, _mm_or_ps(_mm_and_ps(upper, g2), _mm_andnot_ps(upper, g2MinusOne)));
+        __m128 y1 = _mm_add_ps(y0f, _mm_or_ps(_mm_and_ps(upper, g2MinusOne), _mm_andnot_ps(upper, g2)));
+        __m128i i1 = _mm_add_epi32(i, _mm_andnot_si128(upperInt, primeX));
+        __m128i j1 = _mm_add_epi32(j, _mm_and_si128(upperInt, primeY));
+        __m128 b = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1));
+        __m128 n1 = Contribution(b, GradCoord(seed, i1, j1, x1, y1));
+
+        _mm_storeu_ps(out + col, _mm_mul_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2), _mm_set1_ps(kScale)));
+    }
+#endif
+
+    for (; col < width; ++col) {
+        out[col] = m_noise.GetNoise((float)(x0 + col), (float)y);
+    }
+}
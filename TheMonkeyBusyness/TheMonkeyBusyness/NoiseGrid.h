@@ -0,0 +1,23 @@
+#pragma once
+#include "FastNoiseLite.h"
+
+// Samples 2D OpenSimplex2 noise over whole grids instead of one GetNoise call per tile.
+// Fill gives bitwise the same values as FastNoiseLite::GetNoise with the same seed and
+// frequency (the arena must match on server and client), four x samples at a time with SSE2.
+class NoiseGrid
+{
+public:
+    NoiseGrid(int seed, float frequency);
+
+    float Sample(float x, float y) const; // Single value, same as FastNoiseLite::GetNoise
+
+    // out[row * width + col] = Sample(x0 + col, y0 + row)
+    void Fill(int x0, int y0, int width, int height, float* out) const;
+
+private:
+    FastNoiseLite m_noise;
+    int m_seed;
+    float m_frequency;
+
+    void FillRow(int x0, int y, int width, float* out) const;
+};
@@ -1,14 +1,13 @@
 ﻿#include "Orangutan.h"
 
-Orangutan::Orangutan() 
-	: Character(90, 180, 15, 0)
+Orangutan::Orangutan(uint32_t seed) 
+	: Character(90, 180, 15, 0), m_random{ seed }
 {}
 
 void Orangutan::ActivateSpecialAbility() {
-	auto now = std::chrono::steady_clock::now();
-	if (std::chrono::duration_cast<std::chrono::seconds>(now - m_lastAbilityUse).count() >= m_cooldownTime) {
+	if (m_remainingCooldown <= 0) {
 		std::cout << "Orangutan activates Regeneration!\n";
-		m_lastAbilityUse = now;
+		m_remainingCooldown = m_cooldownTime;
 
 		// Regeneration logic
 		int regenerationAmount = GetRandomHealthRegen(5, 20);
@@ -18,17 +17,14 @@ void Orangutan::ActivateSpecialAbility() {
 			<< " HP. New HP: " << m_HP << "\n";
 	}
 	else {
-		int timeLeft = m_cooldownTime - std::chrono::duration_cast<std::chrono::seconds>(now - m_lastAbilityUse).count();
-		std::cout << "Ability is on cooldown. Time left: " << timeLeft << " seconds.\n";
+		std::cout << "Ability is on cooldown. Time left: " << m_remainingCooldown << " seconds.\n";
 	}
 }
 
 
 
-int Orangutan::GetRandomHealthRegen(int min, int max) const
+int Orangutan::GetRandomHealthRegen(int min, int max)
 {
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<> dist(min, max);
-	return dist(gen);
+	// Not uniform_int_distribution, its output differs between standard libraries and replays would too
+	return min + static_cast<int>(m_random() % static_cast<uint32_t>(max - min + 1));
 }
@@ -1,17 +1,16 @@
 #pragma once
+#include <cstdint>
 #include <random>
-//#include "Character.h"
-#include <chrono>
 #include <iostream>
-import CharacterModule;
+#include "Character.h"
 class Orangutan : public Character
 {
 public:
-	Orangutan();
+	explicit Orangutan(uint32_t seed = 0); // Seeds the regeneration rolls, the same seed regenerates the same way
 	void ActivateSpecialAbility()override;
 	~Orangutan() = default;
 private:
-	int GetRandomHealthRegen(int min, int max) const;
-	std::chrono::steady_clock::time_point m_lastAbilityUse;
+	int GetRandomHealthRegen(int min, int max);
+	std::mt19937 m_random;
 };
 
@@ -1,14 +1,24 @@
 ﻿#include "Player.h"
 #include "iostream"
 
+namespace {
+	int RandomMonkeyType()
+	{
+		auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+		std::mt19937 gen(seed);
+		std::uniform_int_distribution<> distrib(0, 3);
+		return distrib(gen);
+	}
+}
+
 Player::Player(float x, float y, int id, const std::string& name)
-	: m_id{ id }, m_name{ name }, m_position{ x, y }
+	: Player(x, y, id, name, RandomMonkeyType())
+{
+}
+
+Player::Player(float x, float y, int id, const std::string& name, int monkeyType)
+	: m_id{ id }, m_monkeyType{ monkeyType }, m_name{ name }, m_position{ x, y }
 {
-	auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-	std::mt19937 gen(seed);
-	std::uniform_int_distribution<> distrib(0, 3);
-	m_monkeyType = distrib(gen);
-	
 	// Alege caracterul pe baza valorii random
 	switch (m_monkeyType) {
 	case 0:
@@ -24,7 +34,7 @@ Player::Player(float x, float y, int id, const std::string& name)
 		std::cout << "Gorilla selected for " << name << std::endl;
 		break;
 	case 3:
-		m_Character = new Orangutan();
+		m_Character = new Orangutan(static_cast<uint32_t>(id));
 		std::cout << "Orangutan selected for " << name << std::endl;
 		break;
 	default:
@@ -48,6 +58,16 @@ Character* Player::GetCharacter() const {
 	return m_Character;
 }
 
+int Player::GetMonkeyType() const
+{
+	return m_monkeyType;
+}
+
+int Player::GetId() const
+{
+	return m_id;
+}
+
 void Player::SetSpawn(Vector2<float> location)
 {
 	m_position = location;
@@ -80,39 +100,34 @@ bool Player::IsSlowed() const {
 void Player::StartDoT(float durationInSeconds) {
 	if (m_isUnderDot) return; // DoT already active
 	m_isUnderDot = true;
-	m_dotStartTime = std::chrono::steady_clock::now();
-	m_dotDuration = durationInSeconds;
+	m_dotTimeLeft = durationInSeconds;
+	m_dotTickTimer = 0.0f;
 }
 
 void Player::StopDoT() {
 	m_isUnderDot = false;
-	m_dotDuration = 0;
+	m_dotTimeLeft = 0;
 }
 
 bool Player::IsUnderDot() const {
 	return m_isUnderDot;
 }
 
-void Player::UpdateDot() {
+void Player::UpdateDot(float deltaTime) {
 	if (!m_isUnderDot) return;
 
-	auto now = std::chrono::steady_clock::now();
-	float elapsedTime = std::chrono::duration<float>(now - m_dotStartTime).count();
-
-	if (elapsedTime >= m_dotDuration) {
+	// Simulation time, not wall time, so replays and fast-forwarded games burn the same
+	m_dotTimeLeft -= deltaTime;
+	if (m_dotTimeLeft <= 0.0f) {
 		StopDoT();
 		return;
 	}
 
-	static float timeSinceLastTick = 0.0f;
-	timeSinceLastTick += elapsedTime;
-
-	if (timeSinceLastTick >= 0.3f) { // Tick every 0.3 seconds
+	m_dotTickTimer += deltaTime;
+	if (m_dotTickTimer >= 0.3f) { // Tick every 0.3 seconds
 		Damage(5);
-		timeSinceLastTick = 0.0f;
+		m_dotTickTimer -= 0.3f;
 	}
-
-	m_dotStartTime = now; //Resets reference time
 }
 
 void Player::UpdatePosition(const Vector2<float>& direction, float deltaTime)
@@ -134,7 +149,7 @@ void Player::UpdateRotation(const Vector2<float>& mousePos)
 	this->m_rotationAngle = CalculateLookAtDirection(mousePos).GetAngleFromNormalizedVector();
 }
 
-void Player::Shoot(const Vector2<float>& mousePosition)
+void Player::Shoot(const Vector2<float>& mousePosition, BulletPool& bullets)
 {
 	// Update rotation based on current mouse position
 	m_rotationAngle = CalculateLookAtDirection(mousePosition).GetAngleFromNormalizedVector();
@@ -143,15 +158,15 @@ void Player::Shoot(const Vector2<float>& mousePosition)
 	Vector2 bulletSpawnPosition = CalculateBulletSpawnPosition();
 	Vector2 shootDirection = CalculateLookAtDirection(mousePosition);
 
-	// Shoot logic (e.g., add bullet to game state)
-	m_weapon.Shoot(bulletSpawnPosition, shootDirection);
+	// Shoot logic, the bullet goes into the game's bullet buffer tagged with this player's id
+	m_weapon.Shoot(bullets, m_id, bulletSpawnPosition, shootDirection);
 }
 
-
 void Player::Update(float deltaTime)
 {
 	// handles updating the timers on the powerup cooldowns
 	m_weapon.Update(deltaTime);
+	m_Character->Update(deltaTime);
 }
 
 bool Player::IsAlive()
@@ -187,25 +202,33 @@ void Player::SetScreenSize(const int screenWidth, const int screenHeight)
 	m_screenHeight = screenHeight;
 }
 
-const std::string& Player::GetName() const { return m_name; }
+int Player::GetScreenWidth() const { return m_screenWidth; }
 
-crow::json::wvalue Player::ToJson() const
-{
-	crow::json::wvalue playerJson;
-	playerJson["id"] = m_id;
-	playerJson["name"] = m_name;
-	playerJson["x"] = m_position.x;
-	playerJson["y"] = m_position.y;
-	playerJson["directionX"] = m_direction.x;
-	playerJson["directionY"] = m_direction.y;
-	playerJson["hp"] = m_Character->GetHealth();
-	playerJson["monkeyType"] = m_monkeyType;
-	playerJson["weapon"] = m_weapon.ToJson();
-	playerJson["isAlive"] = m_isAlive;
+int Player::GetScreenHeight() const { return m_screenHeight; }
 
-	return playerJson;
-}
+const std::string& Player::GetName() const { return m_name; }
 
+void Player::WriteSnapshot(SnapshotWriter& writer) const
+{
+	writer.Key("id");
+	writer.Int(m_id);
+	writer.Key("name");
+	writer.String(m_name);
+	writer.Key("x");
+	writer.Float(m_position.x);
+	writer.Key("y");
+	writer.Float(m_position.y);
+	writer.Key("directionX");
+	writer.Float(m_direction.x);
+	writer.Key("directionY");
+	writer.Float(m_direction.y);
+	writer.Key("hp");
+	writer.Int(m_Character->GetHealth());
+	writer.Key("monkeyType");
+	writer.Int(m_monkeyType);
+	writer.Key("isAlive");
+	writer.Int(m_isAlive);
+}
 
 Vector2<float> Player::CalculateLookAtDirection(const Vector2<float>& mousePos)
 {
@@ -217,7 +240,6 @@ Vector2<float> Player::CalculateLookAtDirection(const Vector2<float>& mousePos)
 		return m_direction;
 }
 
-
 Vector2<float> Player::CalculateBulletSpawnPosition() const
 {
 	float offsetX = cos((m_rotationAngle - GameConfig::kDefaultRotationOffset) * MathConfig::kPi / 180.0f) * (PlayerConfig::kPlayerSize / 2.0f);
@@ -1,7 +1,6 @@
 #pragma once
 #include "Weapon.h"
 #include "ConstantValues.h"
-//#include "Character.h"
 #include "BasicMonkey.h"
 #include "Orangutan.h"
 #include "CapuchinMonkey.h"
@@ -11,16 +10,20 @@
 #include <chrono>
 #include <cstdlib> // Pentru rand() si srand()
 #include <ctime>   // Pentru time()
-import CharacterModule;
+#include "Character.h"
+#include "SnapshotWriter.h"
 class Player : public GameObject { // this is the player, he calls for input and other actions
 public:
 	explicit Player(float x = PlayerConfig::kDefaultPositionX, float y = PlayerConfig::kDefaultPositionY, 
 		int id = PlayerConfig::kDefaultPlayerId, const std::string& name = PlayerConfig::kDefaultPlayerName);
+	Player(float x, float y, int id, const std::string& name, int monkeyType); // Fixed character, used by replays
 	Vector2<float> Forward() const;
 	Vector2<float> GetPosition()const;
 	void SetSpawn(Vector2<float> location);
 	void SetMonkeyType(Character* character);
 	Character* GetCharacter() const;
+	int GetMonkeyType() const;
+	int GetId() const;
 	void SetOldSpeed(int speed);
 	int GetOldSpeed() const;
 	void SetisSlowed(bool isSlowed);
@@ -30,23 +33,26 @@ public:
 	void UpdatePosition(const Vector2<float> &vector, float deltaTime);
 	void UpdatePosition(const float x, const float y);
 	void UpdateRotation(const Vector2<float>& mousePos);
-	void Shoot(const Vector2<float>& mousePosition);
+	void Shoot(const Vector2<float>& mousePosition, BulletPool& bullets);
 	void Update(float deltaTime);
 	bool IsAlive();
 	void Damage(int damageValue);
 	void ActivateAbility();
 	void SetScreenSize(const int screenWidth, const int screenHeight);
+	int GetScreenWidth() const;
+	int GetScreenHeight() const;
 	void StartDoT(float durationInSeconds);
 	void StopDoT();
-	void UpdateDot(); // Update pentru damage periodic
+	void UpdateDot(float deltaTime); // Update pentru damage periodic
 	bool IsUnderDot() const;  // Getter for DoT status
 	const std::string& GetName() const;
 
 	crow::json::wvalue ToJson() const;
+	void WriteSnapshot(SnapshotWriter& writer) const; // Fields of ToJson into an object the caller opened
 private:
 	int m_id;
-	int m_screenWidth;
-	int m_screenHeight;
+	int m_screenWidth = GameConfig::kScreenWidth;
+	int m_screenHeight = GameConfig::kScreenHeight;
 	int m_monkeyType;
 	std::string m_name;
 	int m_oldSpeed;
@@ -57,8 +63,8 @@ private:
 	float m_rotationAngle{ 0 };
 	float m_size{ PlayerConfig::kPlayerSize };
 	bool m_isUnderDot = false; // If player is under DoT effect
-	std::chrono::steady_clock::time_point m_dotStartTime;
-	float m_dotDuration = 0; // DoT duration in seconds
+	float m_dotTimeLeft = 0; // Seconds of DoT left, counted down by UpdateDot
+	float m_dotTickTimer = 0; // Time since the last DoT damage
 	Vector2<float> CalculateLookAtDirection(const Vector2<float>& mousePos);
 	Vector2<float> CalculateBulletSpawnPosition() const;
 	int m_isAlive = {1};
@@ -5,6 +5,7 @@
 #include "Tile.h"
 #include "ConstantValues.h"
 #include "Player.h"
+#include <map>
 #include <memory>
 #include <unordered_map>
 
@@ -13,7 +14,7 @@ public:
     GameObject* Raycast(Vector2<float> origin, Vector2<float> direction, float maxDistance, Player& sender);
     GameObject* Raycast(Vector2<float> origin, Vector2<float> direction, float maxDistance, Player& sender, Vector2<float>& CastResult);
     std::weak_ptr<Arena> m_arena;
-    std::weak_ptr<std::unordered_map<int, Player>> m_players;
+    std::weak_ptr<std::map<int, Player>> m_players;
 private:
     GameObject* HandleTileHit(Vector2<float>& hitLocation);
     GameObject* HandlePlayerHit(Vector2<float>& hitLocation, Player& sender);
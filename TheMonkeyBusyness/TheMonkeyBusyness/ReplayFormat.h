@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+// Replay files, written by ReplayRecorder while a match runs and read back by ReplayReader.
+// Append only, a replay cut short by a crash still plays up to its last flushed record.
+//
+// Layout (all integers little endian, floats as their IEEE bits):
+//   magic 'M','B','R','P' | version u8
+//   then records until the end of the file, each starting with its type u8:
+//     Arena        (1): length u32 | arena in ArenaCodec format, seeded
+//     Player       (2): id i32 | monkeyType u8 | x f32 | y f32 | nameLength u16 | name
+//     RemovePlayer (3): id i32
+//     Resolution   (4): id i32 | width u16 | height u16
+//     Input        (5): id i32 | deltaTime f32 | moveX f32 | moveY f32 | mouseX f32 | mouseY f32 | flags u8
+//     Tick         (6): deltaTime f32
+//     End          (7): tickCount u32 | stateHash u64 -- GameState::StateHash() when recording stopped
+//   Records are in the order they were applied. Inputs and resolutions are the ones the following
+//   tick took from the players' InputQueues, an input is only written when the client sent a new one.
+//   Version 1 applied each input on its own as it arrived.
+
+namespace ReplayFormat {
+    constexpr char kMagic[4] = { 'M', 'B', 'R', 'P' };
+    constexpr uint8_t kVersion = 2;
+    constexpr const char* kExtension = ".mbr";
+
+    enum class RecordType : uint8_t {
+        Arena = 1,
+        Player = 2,
+        RemovePlayer = 3,
+        Resolution = 4,
+        Input = 5,
+        Tick = 6,
+        End = 7
+    };
+
+    constexpr uint8_t kInputShooting = 0x01;
+    constexpr uint8_t kInputSpecialAbility = 0x02;
+}
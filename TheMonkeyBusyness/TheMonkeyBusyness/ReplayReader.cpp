@@ -0,0 +1,98 @@
+#include "ReplayReader.h"
+#include <cstring>
+
+ReplayReader::ReplayReader(std::string_view data) : m_reader{ data }
+{
+    std::string_view magic;
+    uint8_t version;
+    m_valid = m_reader.Bytes(sizeof(ReplayFormat::kMagic), magic) &&
+        std::memcmp(magic.data(), ReplayFormat::kMagic, sizeof(ReplayFormat::kMagic)) == 0 &&
+        m_reader.U8(version) && version == ReplayFormat::kVersion;
+}
+
+bool ReplayReader::IsValid() const
+{
+    return m_valid;
+}
+
+bool ReplayReader::IsTruncated() const
+{
+    return m_truncated;
+}
+
+bool ReplayReader::Next(ReplayRecord& record)
+{
+    if (!m_valid || m_truncated || m_reader.AtEnd()) {
+        return false;
+    }
+    if (!ReadRecord(record)) {
+        m_truncated = true;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayReader::ReadRecord(ReplayRecord& record)
+{
+    using ReplayFormat::RecordType;
+
+    uint8_t type;
+    if (!m_reader.U8(type)) return false;
+    record.type = static_cast<RecordType>(type);
+
+    switch (record.type) {
+    case RecordType::Arena: {
+        uint32_t length;
+        std::string_view arena;
+        return m_reader.U32(length) && m_reader.Bytes(length, arena) && ArenaCodec::Decode(arena, record.arena);
+    }
+    case RecordType::Player: {
+        int32_t id;
+        uint8_t monkeyType;
+        uint16_t nameLength;
+        std::string_view name;
+        if (!m_reader.I32(id) || !m_reader.U8(monkeyType) || !m_reader.F32(record.position.x) || !m_reader.F32(record.position.y) ||
+            !m_reader.U16(nameLength) || !m_reader.Bytes(nameLength, name)) {
+            return false;
+        }
+        record.playerId = id;
+        record.monkeyType = monkeyType;
+        record.name.assign(name);
+        return true;
+    }
+    case RecordType::RemovePlayer: {
+        int32_t id;
+        if (!m_reader.I32(id)) return false;
+        record.playerId = id;
+        return true;
+    }
+    case RecordType::Resolution: {
+        int32_t id;
+        uint16_t width, height;
+        if (!m_reader.I32(id) || !m_reader.U16(width) || !m_reader.U16(height)) return false;
+        record.playerId = id;
+        record.width = width;
+        record.height = height;
+        return true;
+    }
+    case RecordType::Input: {
+        int32_t id;
+        uint8_t flags;
+        PlayerInput& input = record.input;
+        if (!m_reader.I32(id) || !m_reader.F32(record.deltaTime) ||
+            !m_reader.F32(input.movement.x) || !m_reader.F32(input.movement.y) ||
+            !m_reader.F32(input.mousePosition.x) || !m_reader.F32(input.mousePosition.y) || !m_reader.U8(flags)) {
+            return false;
+        }
+        record.playerId = id;
+        input.isShooting = (flags & ReplayFormat::kInputShooting) != 0;
+        input.isSpecialAbility = (flags & ReplayFormat::kInputSpecialAbility) != 0;
+        return true;
+    }
+    case RecordType::Tick:
+        return m_reader.F32(record.deltaTime);
+    case RecordType::End:
+        return m_reader.U32(record.tickCount) && m_reader.U64(record.stateHash);
+    }
+    return false; // Unknown record type
+}
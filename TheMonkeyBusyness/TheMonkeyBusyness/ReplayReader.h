@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "ArenaCodec.h"
+#include "ByteStream.h"
+#include "InputQueue.h"
+#include "ReplayFormat.h"
+
+// One decoded record, only the fields of its type are set
+struct ReplayRecord {
+    ReplayFormat::RecordType type = ReplayFormat::RecordType::End;
+    int playerId = 0;
+    float deltaTime = 0.0f;      // Input, Tick
+    PlayerInput input;           // Input
+    int monkeyType = 0;          // Player
+    Vector2<float> position;     // Player
+    std::string name;            // Player
+    int width = 0;               // Resolution
+    int height = 0;
+    ArenaSnapshot arena;         // Arena
+    uint32_t tickCount = 0;      // End
+    uint64_t stateHash = 0;
+};
+
+// Reads a replay file (see ReplayFormat.h) record by record. The data has to outlive the reader.
+class ReplayReader
+{
+public:
+    explicit ReplayReader(std::string_view data);
+
+    bool IsValid() const;            // Magic and version matched
+    bool Next(ReplayRecord& record); // False at the end of the data or at a malformed record
+    bool IsTruncated() const;        // Stopped on a partial or malformed record instead of the end
+
+private:
+    ByteReader m_reader;
+    bool m_valid = false;
+    bool m_truncated = false;
+
+    bool ReadRecord(ReplayRecord& record);
+};
@@ -0,0 +1,162 @@
+#include "ReplayRecorder.h"
+#include "ByteStream.h"
+#include "ConstantValues.h"
+#include "ReplayFormat.h"
+
+ReplayRecorder::ReplayRecorder(std::shared_ptr<ReplayWriter> writer, const std::string& path)
+    : m_writer{ std::move(writer) }, m_lastFlush{ std::chrono::steady_clock::now() }
+{
+    m_file = m_writer->Open(path);
+    m_buffer.reserve(ReplayConfig::kFlushBytes);
+    m_buffer.append(ReplayFormat::kMagic, sizeof(ReplayFormat::kMagic));
+    ByteWriter(m_buffer).U8(ReplayFormat::kVersion);
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_finished) {
+        Flush(true);
+    }
+}
+
+void ReplayRecorder::RecordArena(const std::string& arenaBinary)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    ByteWriter writer(m_buffer);
+    writer.U8(static_cast<uint8_t>(ReplayFormat::RecordType::Arena));
+    writer.U32(static_cast<uint32_t>(arenaBinary.size()));
+    writer.Bytes(arenaBinary);
+    FlushIfDue();
+}
+
+void ReplayRecorder::RecordPlayer(int playerId, int monkeyType, const Vector2<float>& position, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    ByteWriter writer(m_buffer);
+    writer.U8(static_cast<uint8_t>(ReplayFormat::RecordType::Player));
+    writer.I32(playerId);
+    writer.U8(static_cast<uint8_t>(monkeyType));
+    writer.F32(position.x);
+    writer.F32(position.y);
+    std::string_view nameBytes = std::string_view(name).substr(0, UINT16_MAX);
+    writer.U16(static_cast<uint16_t>(nameBytes.size()));
+    writer.Bytes(nameBytes);
+    FlushIfDue();
+}
+
+void ReplayRecorder::RecordRemovePlayer(int playerId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    ByteWriter writer(m_buffer);
+    writer.U8(static_cast<uint8_t>(ReplayFormat::RecordType::RemovePlayer));
+    writer.I32(playerId);
+    FlushIfDue();
+}
+
+void ReplayRecorder::RecordResolution(int playerId, int width, int height)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    ByteWriter writer(m_buffer);
+    writer.U8(static_cast<uint8_t>(ReplayFormat::RecordType::Resolution));
+    writer.I32(playerId);
+    writer.U16(static_cast<uint16_t>(width));
+    writer.U16(static_cast<uint16_t>(height));
+    FlushIfDue();
+}
+
+void ReplayRecorder::RecordInput(int playerId, const PlayerInput& input, float deltaTime)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    uint8_t flags = 0;
+    if (input.isShooting) {
+        flags |= ReplayFormat::kInputShooting;
+    }
+    if (input.isSpecialAbility) {
+        flags |= ReplayFormat::kInputSpecialAbility;
+    }
+    ByteWriter writer(m_buffer);
+    writer.U8(static_cast<uint8_t>(ReplayFormat::RecordType::Input));
+    writer.I32(playerId);
+    writer.F32(deltaTime);
+    writer.F32(input.movement.x);
+    writer.F32(input.movement.y);
+    writer.F32(input.mousePosition.x);
+    writer.F32(input.mousePosition.y);
+    writer.U8(flags);
+    FlushIfDue();
+}
+
+void ReplayRecorder::RecordTick(float deltaTime)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    ByteWriter writer(m_buffer);
+    writer.U8(static_cast<uint8_t>(ReplayFormat::RecordType::Tick));
+    writer.F32(deltaTime);
+    ++m_tickCount;
+    FlushIfDue();
+}
+
+void ReplayRecorder::Finish(uint64_t stateHash)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        return;
+    }
+    ByteWriter writer(m_buffer);
+    writer.U8(static_cast<uint8_t>(ReplayFormat::RecordType::End));
+    writer.U32(m_tickCount);
+    writer.U64(stateHash);
+    Flush(true);
+    m_finished = true;
+}
+
+const std::string& ReplayRecorder::GetPath() const
+{
+    return m_file->path;
+}
+
+uint32_t ReplayRecorder::GetTickCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tickCount;
+}
+
+void ReplayRecorder::FlushIfDue()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (m_buffer.size() >= static_cast<size_t>(ReplayConfig::kFlushBytes) ||
+        now - m_lastFlush >= std::chrono::milliseconds(ReplayConfig::kFlushIntervalMs)) {
+        Flush(false);
+    }
+}
+
+void ReplayRecorder::Flush(bool close)
+{
+    m_lastFlush = std::chrono::steady_clock::now();
+    if (m_buffer.empty() && !close) {
+        return;
+    }
+    std::string chunk;
+    chunk.reserve(ReplayConfig::kFlushBytes);
+    chunk.swap(m_buffer);
+    m_writer->Write(m_file, std::move(chunk), close);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "InputQueue.h"
+#include "ReplayWriter.h"
+
+// Encodes the replay of one match (see ReplayFormat.h) into memory and passes it to the
+// ReplayWriter every ReplayConfig::kFlushBytes or kFlushIntervalMs. Safe to call from the
+// game loop and the WebSocket threads at once, records keep the order of the calls.
+class ReplayRecorder
+{
+public:
+    ReplayRecorder(std::shared_ptr<ReplayWriter> writer, const std::string& path);
+    ~ReplayRecorder(); // Closes the file, a replay without End is still readable
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    void RecordArena(const std::string& arenaBinary);
+    void RecordPlayer(int playerId, int monkeyType, const Vector2<float>& position, const std::string& name);
+    void RecordRemovePlayer(int playerId);
+    void RecordResolution(int playerId, int width, int height);
+    void RecordInput(int playerId, const PlayerInput& input, float deltaTime);
+    void RecordTick(float deltaTime);
+    void Finish(uint64_t stateHash); // Writes End and closes the file, records after it are dropped
+
+    const std::string& GetPath() const;
+    uint32_t GetTickCount() const;
+
+private:
+    std::shared_ptr<ReplayWriter> m_writer;
+    std::shared_ptr<ReplayWriter::File> m_file;
+    std::string m_buffer;
+    std::chrono::steady_clock::time_point m_lastFlush;
+    uint32_t m_tickCount = 0;
+    bool m_finished = false;
+    mutable std::mutex m_mutex;
+
+    void FlushIfDue(); // Caller holds m_mutex
+    void Flush(bool close);
+};
@@ -0,0 +1,100 @@
+#include "ReplayWriter.h"
+#include <filesystem>
+#include <iostream>
+
+ReplayWriter::ReplayWriter() : m_thread(&ReplayWriter::WriterLoop, this)
+{
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::shared_ptr<ReplayWriter::File> ReplayWriter::Open(const std::string& path)
+{
+    auto file = std::make_shared<File>();
+    file->path = path;
+    return file;
+}
+
+void ReplayWriter::Write(const std::shared_ptr<File>& file, std::string data, bool close)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queuedBytes += data.size();
+        m_chunks.push_back({ file, std::move(data), close });
+    }
+    m_wake.notify_one();
+}
+
+uint64_t ReplayWriter::GetWrittenBytes() const
+{
+    return m_writtenBytes;
+}
+
+uint64_t ReplayWriter::GetQueuedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queuedBytes;
+}
+
+void ReplayWriter::WriterLoop()
+{
+    while (true) {
+        Chunk chunk;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stopping || !m_chunks.empty(); });
+            // Drain the queue even when stopping, the last chunks close the files
+            if (m_chunks.empty()) {
+                return;
+            }
+            chunk = std::move(m_chunks.front());
+            m_chunks.pop_front();
+            m_queuedBytes -= chunk.data.size();
+        }
+        WriteChunk(chunk);
+    }
+}
+
+void ReplayWriter::WriteChunk(Chunk& chunk)
+{
+    File& file = *chunk.file;
+    if (file.failed) {
+        return;
+    }
+
+    if (!file.stream.is_open()) {
+        std::error_code error;
+        std::filesystem::path path(file.path);
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+        file.stream.open(file.path, std::ios::binary | std::ios::trunc);
+        if (!file.stream) {
+            file.failed = true;
+            std::cerr << "Could not open replay file " << file.path << std::endl;
+            return;
+        }
+    }
+
+    file.stream.write(chunk.data.data(), static_cast<std::streamsize>(chunk.data.size()));
+    file.stream.flush();
+    if (!file.stream) {
+        file.failed = true;
+        std::cerr << "Writing replay file " << file.path << " failed" << std::endl;
+        return;
+    }
+    m_writtenBytes += chunk.data.size();
+    if (chunk.close) {
+        file.stream.close();
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Writes replay files on one background thread, game threads only hand over filled buffers.
+// Files are opened on first write, so starting a recording never touches the disk.
+class ReplayWriter
+{
+public:
+    struct File {
+        std::string path;
+        std::ofstream stream; // Only used by the writer thread
+        bool failed = false;
+    };
+
+    ReplayWriter();
+    ~ReplayWriter(); // Writes everything still queued before returning
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    std::shared_ptr<File> Open(const std::string& path);
+    void Write(const std::shared_ptr<File>& file, std::string data, bool close = false);
+
+    uint64_t GetWrittenBytes() const;
+    uint64_t GetQueuedBytes() const;
+
+private:
+    struct Chunk {
+        std::shared_ptr<File> file;
+        std::string data;
+        bool close;
+    };
+
+    std::deque<Chunk> m_chunks;
+    uint64_t m_queuedBytes = 0;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::atomic<uint64_t> m_writtenBytes{ 0 };
+    std::thread m_thread;
+
+    void WriterLoop();
+    void WriteChunk(Chunk& chunk);
+};
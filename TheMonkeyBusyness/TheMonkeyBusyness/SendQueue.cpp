@@ -0,0 +1,72 @@
+#include "SendQueue.h"
+#include <algorithm>
+
+SendQueue::SendQueue(size_t capacity) : m_capacity{ capacity }
+{
+}
+
+SendQueue::PushResult SendQueue::Push(std::shared_ptr<const std::string> payload, bool isSnapshot)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (isSnapshot && m_pendingSnapshot >= 0) {
+        // Keep the original queue time, the client has been waiting on a snapshot since then
+        m_messages[m_pendingSnapshot].payload = std::move(payload);
+        ++m_replacedTotal;
+        return PushResult::Replaced;
+    }
+
+    if (m_messages.size() >= m_capacity) {
+        m_overflowed = true;
+        ++m_overflowTotal;
+        return PushResult::Overflow;
+    }
+
+    m_pendingSnapshot = isSnapshot ? static_cast<int>(m_messages.size()) : -1;
+    m_messages.push_back({ std::move(payload), isSnapshot, std::chrono::steady_clock::now() });
+    return PushResult::Queued;
+}
+
+void SendQueue::Pop(std::vector<OutboundMessage>& out, size_t maxCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = std::min(maxCount, m_messages.size());
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(std::move(m_messages[i]));
+    }
+    m_messages.erase(m_messages.begin(), m_messages.begin() + count);
+    m_pendingSnapshot = m_pendingSnapshot >= static_cast<int>(count) ? m_pendingSnapshot - static_cast<int>(count) : -1;
+}
+
+size_t SendQueue::GetDepth() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_messages.size();
+}
+
+std::chrono::steady_clock::duration SendQueue::GetOldestAge() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_messages.empty()) {
+        return std::chrono::steady_clock::duration::zero();
+    }
+    return std::chrono::steady_clock::now() - m_messages.front().queuedAt;
+}
+
+bool SendQueue::HasOverflowed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_overflowed;
+}
+
+uint64_t SendQueue::GetReplacedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_replacedTotal;
+}
+
+uint64_t SendQueue::GetOverflowCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_overflowTotal;
+}
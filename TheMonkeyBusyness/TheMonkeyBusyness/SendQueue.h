@@ -0,0 +1,50 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ConstantValues.h"
+
+struct OutboundMessage {
+    std::shared_ptr<const std::string> payload; // Shared between every connection of a broadcast
+    bool isSnapshot;
+    std::chrono::steady_clock::time_point queuedAt;
+};
+
+// Bounded outbox of one client connection. A snapshot supersedes any snapshot still waiting,
+// so a client that can't keep up gets fewer, fresher updates instead of a growing backlog.
+// Other messages keep their order and count against the capacity, a snapshot queued before one
+// of them is no longer replaced so the client never gets an older state after a newer one.
+class SendQueue
+{
+public:
+    enum class PushResult {
+        Queued,
+        Replaced, // An older unsent snapshot was overwritten
+        Overflow  // Full, message dropped
+    };
+
+    explicit SendQueue(size_t capacity = NetworkConfig::kSendQueueCapacity);
+
+    PushResult Push(std::shared_ptr<const std::string> payload, bool isSnapshot);
+    void Pop(std::vector<OutboundMessage>& out, size_t maxCount); // Appends the oldest maxCount messages
+
+    size_t GetDepth() const;
+    std::chrono::steady_clock::duration GetOldestAge() const; // Zero when empty
+    bool HasOverflowed() const; // A message was dropped, the client's view is no longer consistent
+
+    uint64_t GetReplacedCount() const;
+    uint64_t GetOverflowCount() const;
+
+private:
+    size_t m_capacity;
+    std::deque<OutboundMessage> m_messages;
+    int m_pendingSnapshot = -1; // Index of the unsent snapshot in m_messages
+    bool m_overflowed = false;
+    uint64_t m_replacedTotal = 0;
+    uint64_t m_overflowTotal = 0;
+    mutable std::mutex m_mutex;
+};
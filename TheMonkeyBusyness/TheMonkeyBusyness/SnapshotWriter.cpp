@@ -0,0 +1,112 @@
+#include "SnapshotWriter.h"
+#include <charconv>
+#include <cmath>
+
+void SnapshotWriter::Reset()
+{
+    m_buffer.clear();
+    m_depth = 0;
+    m_hasItems[0] = false;
+    m_afterKey = false;
+}
+
+const std::string& SnapshotWriter::GetBuffer() const
+{
+    return m_buffer;
+}
+
+void SnapshotWriter::BeginObject()
+{
+    BeforeValue();
+    m_buffer += '{';
+    m_hasItems[++m_depth] = false;
+}
+
+void SnapshotWriter::EndObject()
+{
+    m_buffer += '}';
+    --m_depth;
+}
+
+void SnapshotWriter::BeginArray()
+{
+    BeforeValue();
+    m_buffer += '[';
+    m_hasItems[++m_depth] = false;
+}
+
+void SnapshotWriter::EndArray()
+{
+    m_buffer += ']';
+    --m_depth;
+}
+
+void SnapshotWriter::Key(std::string_view key)
+{
+    BeforeValue();
+    m_buffer += '"';
+    m_buffer += key;
+    m_buffer += "\":";
+    m_afterKey = true;
+}
+
+void SnapshotWriter::Int(int64_t value)
+{
+    BeforeValue();
+    char text[24];
+    auto [end, error] = std::to_chars(text, text + sizeof(text), value);
+    m_buffer.append(text, end);
+}
+
+void SnapshotWriter::Float(float value)
+{
+    BeforeValue();
+    if (!std::isfinite(value)) {
+        m_buffer += '0';
+        return;
+    }
+    char text[32];
+    auto [end, error] = std::to_chars(text, text + sizeof(text), value);
+    m_buffer.append(text, end);
+}
+
+void SnapshotWriter::Bool(bool value)
+{
+    BeforeValue();
+    m_buffer += value ? "true" : "false";
+}
+
+void SnapshotWriter::String(std::string_view value)
+{
+    BeforeValue();
+    m_buffer += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            m_buffer += '\\';
+            m_buffer += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            static constexpr char kHex[] = "0123456789abcdef";
+            m_buffer += "\\u00";
+            m_buffer += kHex[(c >> 4) & 0xF];
+            m_buffer += kHex[c & 0xF];
+        }
+        else {
+            m_buffer += c;
+        }
+    }
+    m_buffer += '"';
+}
+
+void SnapshotWriter::BeforeValue()
+{
+    // A value right after its key, otherwise a new item of the enclosing object or array
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+    if (m_hasItems[m_depth]) {
+        m_buffer += ',';
+    }
+    m_hasItems[m_depth] = true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Writes snapshot JSON straight into a buffer the owner keeps between ticks. Reset() keeps the
+// capacity, so once the buffer has grown to the largest snapshot nothing is allocated anymore.
+// Only checks what it needs for commas: keys and values have to come in a valid order.
+class SnapshotWriter
+{
+public:
+    static constexpr int kMaxDepth = 16;
+
+    void Reset();
+    const std::string& GetBuffer() const;
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key(std::string_view key); // Keys are written as is, no escaping
+
+    void Int(int64_t value);
+    void Float(float value); // Shortest text that reads back the same float, non-finite values as 0
+    void Bool(bool value);
+    void String(std::string_view value);
+
+private:
+    std::string m_buffer;
+    bool m_hasItems[kMaxDepth] = {}; // Per open object/array, whether the next item needs a comma
+    int m_depth = 0;
+    bool m_afterKey = false;
+
+    void BeforeValue();
+};
@@ -88,11 +88,3 @@ void Tile::updateProperties() {
     }
 }
 
-crow::json::wvalue Tile::ToJson() const {
-	crow::json::wvalue tileJson;
-	tileJson["type"] = static_cast<int>(m_tileType);
-	tileJson["hp"] = m_hp;
-	tileJson["occupied"] = m_playerOccupied;
-	return tileJson;
-}
-
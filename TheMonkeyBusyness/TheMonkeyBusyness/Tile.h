@@ -1,8 +1,8 @@
 #pragma once
 #include <string>
 #include "GameObject.h"
-#include <crow.h>
-import TileTypeModule;
+#include "JsonFwd.h"
+#include "TileType.h"
 class Tile : public GameObject
 {
 private:
@@ -1,14 +1,14 @@
-//#pragma once
-//#include <cstdint>
-//enum class TileType : uint8_t
-//{
-//	Empty,
-//	Spawn,
-//	IndestructibleWall,
-//	DestructibleWall,
-//	Water,
-//	Grass,
-//	Lava,
-//	Teleporter,
-//	FakeDestructibleWall
-//};
\ No newline at end of file
+#pragma once
+#include <cstdint>
+enum class TileType : uint8_t
+{
+	Empty,
+	Spawn,
+	IndestructibleWall,
+	DestructibleWall,
+	Water,
+	Grass,
+	Lava,
+	Teleporter,
+	FakeDestructibleWall
+};
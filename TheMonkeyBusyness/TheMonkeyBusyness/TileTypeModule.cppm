@@ -1,14 +0,0 @@
-export module TileTypeModule;
-import <cstdint>;
-export enum class TileType : uint8_t
-{
-	Empty,
-	Spawn,
-	IndestructibleWall,
-	DestructibleWall,
-	Water,
-	Grass,
-	Lava,
-	Teleporter,
-	FakeDestructibleWall
-};
\ No newline at end of file
@@ -30,12 +30,10 @@ User::User(const std::string& username, const std::string& password, int scr, in
         << ", Password: " << m_password << std::endl;
 }
 
+// Validates like the full constructor, /signin relies on the validity flags being set
 User::User(const std::string& username, const std::string& password)
+    : User(username, password, 0, 0)
 {
-    m_username = username;
-    m_password = password;
-    m_score = 0;
-    m_upgradePoints = 0;
 }
 
 int User::GetUserId() const
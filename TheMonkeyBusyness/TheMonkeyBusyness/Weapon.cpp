@@ -4,24 +4,13 @@
 Weapon::Weapon(float damage, float fireRate, float speed)
 	: m_damage{ damage }, m_fireRate{ fireRate }, m_speed{ speed }, m_timeSinceLastShot{ 0.0f }, m_damageIncreaseTimer{ 0.0f }, m_speedIncreaseTimer{ 0.0f }
 {
-	initializeBullets();
 }
 
-void Weapon::Shoot(const Vector2<float>& position, const Vector2<float>& direction) {
+void Weapon::Shoot(BulletPool& bullets, int ownerId, const Vector2<float>& position, const Vector2<float>& direction) {
 
 	if (m_timeSinceLastShot >= m_fireRate) {
-		if (!m_inactiveBullets.empty()) {
-			// Bullet activation logic
-
-			m_inactiveBullets.back().SetPosition(position);
-			m_inactiveBullets.back().SetDirection(direction);
-			m_activeBullets.push_back(std::move(m_inactiveBullets.back()));
-			m_inactiveBullets.pop_back();
+		if (bullets.Spawn(ownerId, position, direction, getBulletSpeed(), getBulletDamage())) {
 			m_timeSinceLastShot = 0.0f;
-
-
-			if (hasActivePowerup())
-				activateBulletPowerup(m_activeBullets.back());
 		}
 	}
 }
@@ -35,24 +24,6 @@ void Weapon::Update(float deltaTime)
 }
 
 
-void Weapon::deactivateBullet(size_t index)
-{
-	if (index < m_activeBullets.size())
-	{
-		m_inactiveBullets.push_back(std::move(m_activeBullets[index]));
-		m_activeBullets.erase(m_activeBullets.begin() + index);
-	}
-}
-
-void Weapon::initializeBullets()
-{
-	m_activeBullets.reserve(WeaponConfig::kMaxBasicBullets);
-	m_inactiveBullets.reserve(WeaponConfig::kMaxBasicBullets);
-
-	for (size_t i = 0; i < WeaponConfig::kMaxBasicBullets; ++i)
-		m_inactiveBullets.push_back(Bullet(Vector2<float>(), Vector2<float>(), m_speed, m_damage));
-}
-
 void Weapon::ActivateDamagePowerup(float duration)
 {
 	m_damageIncreaseTimer += duration;
@@ -68,44 +39,27 @@ bool Weapon::hasActivePowerup() const
 	return m_damageIncreaseTimer > 0 || m_speedIncreaseTimer > 0;
 }
 
-void Weapon::activateBulletPowerup(Bullet& bullet) const
+float Weapon::getBulletDamage() const
 {
-	if (m_damageIncreaseTimer)
-		bullet.SetDamage(bullet.GetDamage() * (1 + WeaponConfig::kDamagePowerupIncreasePercent / 100.0f));
-	if (m_speedIncreaseTimer)
-		bullet.SetSpeed(bullet.GetSpeed() * (1 + WeaponConfig::kSpeedPowerupIncreasePercent / 100.0f));
+	if (m_damageIncreaseTimer > 0)
+		return m_damage * (1 + WeaponConfig::kDamagePowerupIncreasePercent / 100.0f);
+	return m_damage;
 }
 
-void Weapon::deactivateBulletsPowerup()
+float Weapon::getBulletSpeed() const
 {
-	for(Bullet& bullet : m_activeBullets)
-	{
-		bullet.SetDamage(m_damage);
-		bullet.SetSpeed(m_speed);
-	}
-
-	for (Bullet& bullet : m_inactiveBullets)
-	{
-		bullet.SetDamage(m_damage);
-		bullet.SetSpeed(m_speed);
-	}
+	if (m_speedIncreaseTimer > 0)
+		return m_speed * (1 + WeaponConfig::kSpeedPowerupIncreasePercent / 100.0f);
+	return m_speed;
 }
 
 void Weapon::updatePowerupsTimeLeft(float deltaTime)
 {
 	if (m_damageIncreaseTimer > 0)
-	{
 		m_damageIncreaseTimer -= deltaTime;
-		if (m_damageIncreaseTimer <= 0)
-			deactivateBulletsPowerup();
-	}
 
 	if (m_speedIncreaseTimer > 0)
-	{
 		m_speedIncreaseTimer -= deltaTime;
-		if (m_speedIncreaseTimer <= 0)
-			deactivateBulletsPowerup();
-	}
 }
 
 float Weapon::GetDamage() const {
@@ -131,22 +85,3 @@ float Weapon::GetSpeed() const {
 void Weapon::SetSpeed(float speed) {
 	m_speed = speed;
 }
-
-crow::json::wvalue Weapon::ToJson() const {
-	crow::json::wvalue weaponJson;
-
-	crow::json::wvalue bulletsJson = crow::json::wvalue::list();
-	size_t bulletIndex = 0;
-	for (const auto& bullet : m_activeBullets) {
-		bulletsJson[bulletIndex++] = bullet.ToJson();
-	}
-	weaponJson["bullets"] = std::move(bulletsJson);
-
-	return weaponJson;
-}
-
-
-std::vector<Bullet>& Weapon::GetActiveBullets()
-{
-	return m_activeBullets;
-}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "WorkerPool.h"
+#include <algorithm>
+#include <atomic>
+
+WorkerPool::WorkerPool(size_t threadCount)
+{
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+WorkerPool& WorkerPool::Shared()
+{
+    static WorkerPool pool;
+    return pool;
+}
+
+size_t WorkerPool::DefaultThreadCount()
+{
+    // Leave one core for the threads that submit work, they help out in ParallelFor anyway
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 1;
+}
+
+size_t WorkerPool::GetThreadCount() const
+{
+    return m_threads.size();
+}
+
+void WorkerPool::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void WorkerPool::WorkerLoop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+void WorkerPool::ParallelFor(int begin, int end, int minChunk, const std::function<void(int, int)>& body)
+{
+    int count = end - begin;
+    if (count <= 0) {
+        return;
+    }
+
+    int maxChunks = static_cast<int>(m_threads.size()) + 1;
+    int chunkCount = std::clamp(count / std::max(minChunk, 1), 1, maxChunks);
+    if (chunkCount == 1) {
+        body(begin, end);
+        return;
+    }
+
+    struct Shared {
+        std::atomic<int> nextChunk{ 0 };
+        int finishedChunks = 0;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto shared = std::make_shared<Shared>();
+    int chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    // Helpers that start after all chunks are taken return immediately, so nothing waits on a queued task
+    auto runChunks = [shared, begin, end, chunkSize, chunkCount, &body]() {
+        int chunk;
+        while ((chunk = shared->nextChunk.fetch_add(1)) < chunkCount) {
+            int first = begin + chunk * chunkSize;
+            int last = std::min(first + chunkSize, end);
+            if (first < last) {
+                body(first, last);
+            }
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            if (++shared->finishedChunks == chunkCount) {
+                shared->finished.notify_all();
+            }
+        }
+    };
+
+    for (int i = 1; i < chunkCount; ++i) {
+        Enqueue(runChunks);
+    }
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->finished.wait(lock, [&shared, chunkCount]() { return shared->finishedChunks == chunkCount; });
+}
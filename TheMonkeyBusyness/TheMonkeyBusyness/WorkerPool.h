@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of background threads for CPU heavy work (arena generation) that must not run
+// on request threads or while a game mutex is held.
+class WorkerPool
+{
+public:
+    explicit WorkerPool(size_t threadCount = DefaultThreadCount());
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    template <typename Task>
+    auto Submit(Task&& task) -> std::future<std::invoke_result_t<Task>>
+    {
+        using Result = std::invoke_result_t<Task>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+        std::future<Result> result = packaged->get_future();
+        Enqueue([packaged]() { (*packaged)(); });
+        return result;
+    }
+
+    // Runs body(first, last) over [begin, end) in chunks of at least minChunk items. The calling
+    // thread takes chunks too and only waits for chunks already being worked on, so it is safe
+    // to call from inside a pool task even when every worker is busy.
+    void ParallelFor(int begin, int end, int minChunk, const std::function<void(int, int)>& body);
+
+    size_t GetThreadCount() const;
+
+    static WorkerPool& Shared();
+    static size_t DefaultThreadCount();
+
+private:
+    std::vector<std::thread> m_threads;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+
+    void Enqueue(std::function<void()> task);
+    void WorkerLoop();
+};
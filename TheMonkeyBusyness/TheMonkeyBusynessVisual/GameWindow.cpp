@@ -5,6 +5,10 @@
 #include <fstream>
 #include <QtWidgets/qmessagebox.h>
 #include <thread>
+#include <chrono>
+#include <future>
+#include <algorithm>
+#include <cstdlib>
 #include <QtWidgets/QApplication>
 GameWindow::GameWindow(Player& player, QWidget* parent)
     : QWidget(parent), m_player(player), m_playerInput(this) {
@@ -23,6 +27,7 @@ GameWindow::GameWindow(Player& player, QWidget* parent)
     m_timer = new QTimer(this);
     QObject::connect(m_timer, &QTimer::timeout, [this]() {
         SendInputToServer(); 
+        PollArenaResync();
         m_bulletRotationAngle += 5.0f; 
         if (m_bulletRotationAngle >= 360.0f) {
             m_bulletRotationAngle -= 360.0f;
@@ -51,6 +56,7 @@ void GameWindow::startConnection() {
             {
                 if (response->type == ix::WebSocketMessageType::Message)
                 {
+                    ++m_receivedMessages;
                     //Extract the payload (JSON string) from the WebSocket response
                     const std::string& jsonPayload = response->str;
 
@@ -61,6 +67,25 @@ void GameWindow::startConnection() {
                     UpdateGameState(jsonResponse);
 
                 }
+                else if (response->type == ix::WebSocketMessageType::Open)
+                {
+                    // Bind this connection to our player, inputs after this don't carry the ids.
+                    // The socket reconnects on its own after a drop, then the token picks the game back up
+                    // and the server only sends the map changes after the version we already have
+                    m_receivedMessages = 0;
+                    m_sentWidth = width();
+                    m_sentHeight = height();
+                    std::string resolution = R"(,"width":)" + std::to_string(m_sentWidth) +
+                        R"(,"height":)" + std::to_string(m_sentHeight) +
+                        R"(,"arenaVersion":)" + std::to_string(m_arenaVersion.load()) + "}";
+                    if (!m_player.GetResumeToken().empty()) {
+                        sendMessage(R"({"type":"resume","token":")" + m_player.GetResumeToken() + "\"" + resolution);
+                    }
+                    else {
+                        sendMessage(R"({"type":"join","playerId":)" + std::to_string(m_player.GetId()) +
+                            R"(,"gameId":)" + std::to_string(m_player.GetGameId()) + resolution);
+                    }
+                }
                 else if (response->type == ix::WebSocketMessageType::Error)
                 {
                     std::cerr << "WebSocket error: " << response->errorInfo.reason << std::endl;
@@ -92,22 +117,80 @@ void GameWindow::FetchArena() {
     );
 
     if (response.status_code == 200) {
-        auto jsonResponse = crow::json::load(response.text);
-        if (jsonResponse.has("arena")) {
-            LoadArena(jsonResponse);
+        ArenaSnapshot arena;
+        if (ArenaCodec::Decode(response.text, arena)) {
+            ArenaGenerator::Materialize(arena); // Seeded arenas are generated locally
+            LoadArena(arena);
+            m_arenaVersion = std::strtoull(response.header["X-Arena-Version"].c_str(), nullptr, 10);
             update();
         }
+        else {
+            std::cerr << "Received a malformed arena from the server." << std::endl;
+        }
     }
 }
 
-void GameWindow::LoadArena(const crow::json::rvalue& arenaData) {
-    m_map.clear();
-    for (const auto& row : arenaData["arena"]) {
-        std::vector<int> mapRow;
-        for (const auto& tile : row) {
-            mapRow.push_back(tile.i());
+void GameWindow::PollArenaResync() {
+    if (m_resyncFetch) {
+        if (m_resyncFetch->wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
         }
-        m_map.push_back(std::move(mapRow));
+        cpr::Response response = m_resyncFetch->get();
+        m_resyncFetch.reset();
+        ApplyArenaDelta(response);
+        m_resyncPending = false;
+        return;
+    }
+
+    // Off the socket thread, snapshots keep coming in while the changes download
+    if (m_resyncPending) {
+        m_resyncFetch = cpr::GetAsync(
+            cpr::Url{ m_player.GetServerUrl() + "/game_arena_delta" },
+            cpr::Parameters{ {"gameId", std::to_string(m_player.GetGameId())}, {"since", std::to_string(m_resyncSince.load())} }
+        );
+    }
+}
+
+void GameWindow::ApplyArenaDelta(cpr::Response& response) {
+    if (response.status_code != 200) {
+        return;
+    }
+
+    // The server answers with the whole arena when it no longer has changes that old
+    if (!ArenaCodec::IsDelta(response.text)) {
+        ArenaSnapshot arena;
+        if (ArenaCodec::Decode(response.text, arena)) {
+            ArenaGenerator::Materialize(arena);
+            LoadArena(arena);
+            RaiseArenaVersion(std::strtoull(response.header["X-Arena-Version"].c_str(), nullptr, 10));
+        }
+        return;
+    }
+
+    ArenaDelta delta;
+    if (!ArenaCodec::DecodeDelta(response.text, delta)) {
+        std::cerr << "Received a malformed arena delta from the server." << std::endl;
+        return;
+    }
+    for (const auto& change : delta.changes) {
+        if (change.y >= 0 && change.y < m_map.size() && change.x >= 0 && change.x < m_map[change.y].size()) {
+            m_map[change.y][change.x] = change.type;
+        }
+    }
+    RaiseArenaVersion(delta.version);
+}
+
+void GameWindow::RaiseArenaVersion(uint64_t version) {
+    uint64_t current = m_arenaVersion;
+    while (current < version && !m_arenaVersion.compare_exchange_weak(current, version)) {
+    }
+}
+
+void GameWindow::LoadArena(const ArenaSnapshot& arena) {
+    m_map.assign(arena.dim, std::vector<int>(arena.dim));
+    for (int i = 0; i < arena.dim; ++i) {
+        const uint8_t* row = arena.tiles.data() + i * arena.dim;
+        std::copy(row, row + arena.dim, m_map[i].begin());
     }
 }
 
@@ -120,6 +203,7 @@ void GameWindow::UpdateGameState(const crow::json::rvalue& jsonResponse) {
 
     m_bulletsCoordinates.clear();
 
+    // Players far from our screen are only sent now and then, the others keep their last state
     for (const auto& playerData : jsonResponse["players"]) {
         int id = playerData["id"].i();
 
@@ -131,7 +215,16 @@ void GameWindow::UpdateGameState(const crow::json::rvalue& jsonResponse) {
         ProcessBullets(playerData);
     }
 
+    // Missed changes the server no longer has for us, the UI timer fetches them.
+    // Remember where we were before this snapshot moves the version on, later flags wait for that fetch
+    if (jsonResponse.has("arenaResync") && !m_resyncPending) {
+        m_resyncSince = m_arenaVersion.load();
+        m_resyncPending = true;
+    }
     ProcessMapChanges(jsonResponse["mapChanges"]);
+    if (jsonResponse.has("arenaVersion")) {
+        RaiseArenaVersion(jsonResponse["arenaVersion"].u());
+    }
 }
 
 
@@ -140,17 +233,24 @@ void GameWindow::SendInputToServer() {
  
 
     std::string payload = R"({
-        "playerId":)" + std::to_string(m_player.GetId()) + R"(,
-        "gameId":)" + std::to_string(m_player.GetGameId()) + R"(,
         "deltaX":)" + std::to_string(m_playerInput.m_direction.x()) + R"(,
         "deltaY":)" + std::to_string(m_playerInput.m_direction.y()) + R"(,
         "is_shooting":)" + std::to_string((int)m_playerInput.is_shooting) + R"(,
         "is_specialAblity":)" + std::to_string((int)m_playerInput.is_specialAbility) + R"(,
-        "width":)" + std::to_string(width()) + R"(,
-        "height":)" + std::to_string(height()) + R"(,
         "mouseX":)" + std::to_string(m_playerInput.m_mousePosition.x()) + R"(,
-        "mouseY":)" + std::to_string(m_playerInput.m_mousePosition.y()) + R"(})";
-        
+        "mouseY":)" + std::to_string(m_playerInput.m_mousePosition.y()) + R"(,
+        "received":)" + std::to_string(m_receivedMessages.load());
+
+    // The server keeps the resolution from the join, only tell it about resizes
+    if (width() != m_sentWidth || height() != m_sentHeight) {
+        m_sentWidth = width();
+        m_sentHeight = height();
+        payload += R"(,
+        "width":)" + std::to_string(m_sentWidth) + R"(,
+        "height":)" + std::to_string(m_sentHeight);
+    }
+    payload += "}";
+
     sendMessage(payload);
 }
 
@@ -387,6 +487,13 @@ void GameWindow::UpdatePlayerState(const crow::json::rvalue& playerData) {
 void GameWindow::UpdateOtherPlayers(const crow::json::rvalue& playerData) {
     std::string name = playerData["name"].s();
     Position position = { playerData["x"].d(), playerData["y"].d() };
+    if (!playerData.has("hp")) {
+        // Coarse update of a player outside our screen, keep what we knew about the rest
+        PlayerData& data = m_playersData[name];
+        data.m_position = position;
+        data.m_isAlive = playerData["isAlive"].i();
+        return;
+    }
     Direction direction = { playerData["directionX"].d(), playerData["directionY"].d() };
     int health = playerData["hp"].i();
     int monkeyType = playerData["monkeyType"].i();
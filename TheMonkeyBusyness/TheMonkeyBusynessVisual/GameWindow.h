@@ -2,6 +2,8 @@
 #define GAMEWINDOW_H
 #include <QtWidgets/QWidget>
 #include <QtCore/QTimer>
+#include <atomic>
+#include <optional>
 #include <string>
 #include <vector>
 #include <qobject.h>
@@ -9,6 +11,8 @@
 #include "Player.h"
 #include "InputHandler.h"
 #include "EndGameWindow.h"
+#include "ArenaCodec.h"
+#include "ArenaGenerator.h"
 #include <ixwebsocket/IXWebSocket.h>
 #include <ixwebsocket/IXNetSystem.h>
 struct PlayerData {
@@ -46,9 +50,19 @@ private:
     QPixmap m_banana;
     float m_bulletRotationAngle = 0.0f;
     bool m_gameOver = { false };
+    int m_sentWidth = 0;                  // Resolution the server last heard about
+    int m_sentHeight = 0;
+    std::atomic<uint64_t> m_arenaVersion{ 0 }; // Server map changes already in m_map, raised from the socket thread too
+    std::atomic<bool> m_resyncPending{ false }; // Set by a snapshot with arenaResync, fetched from the UI timer
+    std::atomic<uint64_t> m_resyncSince{ 0 };   // Our version when the server told us to resync
+    std::optional<cpr::AsyncResponse> m_resyncFetch; // In flight while it has a value, UI thread only
+    std::atomic<uint64_t> m_receivedMessages{ 0 }; // On the current connection, the server holds back sends until we report them
     // Core Game Loop Methods
     void FetchArena();                  // Fetch the whole arena from the server
-    void LoadArena(const crow::json::rvalue& arenaData);
+    void PollArenaResync();             // Starts or finishes the catch-up on missed map changes, never blocks
+    void ApplyArenaDelta(cpr::Response& response);
+    void RaiseArenaVersion(uint64_t version);
+    void LoadArena(const ArenaSnapshot& arena);
     void UpdateGameState(const crow::json::rvalue& jsonResponse); // Orchestrates the update logic
     void SendInputToServer();           // Sends player input (movement and shooting) to the server
     void paintEvent(QPaintEvent* event) override; // Render the game window
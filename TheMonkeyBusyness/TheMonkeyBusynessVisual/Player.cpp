@@ -63,6 +63,9 @@ int Player::CreateLobby() {
         auto jsonResponse = crow::json::load(response.text);
         if (jsonResponse && jsonResponse.has("lobbyId")) {
             m_lobbyId = jsonResponse["lobbyId"].i();
+            if (jsonResponse.has("resumeToken")) {
+                m_resumeToken = jsonResponse["resumeToken"].s();
+            }
             SetHost(true);
             return m_lobbyId;
         }
@@ -79,7 +82,15 @@ bool Player::JoinLobby(int lobbyId) {
         cpr::Body{ R"({"lobbyId":)" + std::to_string(lobbyId) + R"(,"playerId":)" + std::to_string(m_id) + R"(})" }
     );
 
-    return response.status_code == 200;
+    if (response.status_code != 200) {
+        return false;
+    }
+    // Our only copy, the server doesn't hand it out again
+    auto jsonResponse = crow::json::load(response.text);
+    if (jsonResponse && jsonResponse.has("resumeToken")) {
+        m_resumeToken = jsonResponse["resumeToken"].s();
+    }
+    return true;
 }
 
 bool Player::LeaveLobby() {
@@ -91,6 +102,7 @@ bool Player::LeaveLobby() {
 
     if (response.status_code == 200) {
         m_lobbyId = -1;       // Reset lobbyId
+        m_resumeToken.clear();
         SetHost(false);     
         return true;
     }
@@ -159,6 +171,9 @@ int Player::StartGame() {
         auto jsonResponse = crow::json::load(response.text);
         if (jsonResponse.has("gameId")) {
             m_gameId = jsonResponse["gameId"].i(); // Assign the gameId to this player
+            if (jsonResponse.has("resumeToken")) {
+                m_resumeToken = jsonResponse["resumeToken"].s();
+            }
             return m_gameId;
         }
         else {
@@ -194,6 +209,11 @@ int Player::GetisAlive() const
     return m_isAlive;
 }
 
+const std::string& Player::GetResumeToken() const
+{
+    return m_resumeToken;
+}
+
 void Player::SetGameId(int id) { m_gameId = id; }
 void Player::SetLobbyId(int newLobbyId) { m_lobbyId = newLobbyId; }
 void Player::SetHost(bool hostStatus) { m_isHost = hostStatus; }
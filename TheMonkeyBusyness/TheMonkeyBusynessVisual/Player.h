@@ -36,6 +36,7 @@ public:
     int GetHealth() const;
     int GetMonkeyType()const;
     int GetisAlive() const;
+    const std::string& GetResumeToken() const;
 
     // Mutators
     void SetGameId(int id);
@@ -61,4 +62,5 @@ private:
     Position m_position;                 // Player's current position
     Direction m_direction;               // Player's current direction
     int m_isAlive;                       // If the player is alive
+    std::string m_resumeToken;           // Rebinds a dropped game connection, issued when we enter a lobby
 };
@@ -1,34 +1,103 @@
 #pragma once
 #include <iostream>
 #include <concepts>
+#include <cmath>
 
-
-#ifdef VECTOR2_EXPORTS
-#define VECTOR2_API __declspec(dllexport)  // Export template class and functions
-#else
-#define VECTOR2_API __declspec(dllimport)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define VECTOR2_SSE
 #endif
 
+// Header only so every operator can be inlined and folded at the call site.
 template <std::floating_point T>
-class VECTOR2_API Vector2 {
-	//static_assert(std::is_floating_point_v<T>, "Vector2 can only be instantiated with floating-point types (float or double).");
+class Vector2 {
 public:
 	T x;
 	T y;
-	Vector2(T x = 0, T y = 0);
-	static Vector2 Normalize(const Vector2 vector2);
-	void Normalize();
-	Vector2 operator*(const Vector2 &vector)const;
-	Vector2 operator*(const T scalar)const;
-	Vector2& operator*=(const T scalar);
-	Vector2 operator/(const T scalar)const;
-	Vector2& operator/=(const T scalar);
-	Vector2 operator+(const Vector2& vector) const;
-	Vector2& operator+=(const Vector2& vector);
-	Vector2 operator-(const Vector2& other) const;
-	bool operator==(const Vector2& other) const;
-	bool operator!=(const Vector2& other) const;
-	friend std::ostream& operator<<(std::ostream& os, const Vector2& vector); 
-	T GetAngleFromNormalizedVector() const;
-};
 
+	constexpr Vector2(T x = 0, T y = 0) : x(x), y(y) {}
+
+	constexpr T LengthSquared() const { return x * x + y * y; }
+	T Length() const { return std::sqrt(LengthSquared()); }
+	constexpr T Dot(const Vector2& other) const { return x * other.x + y * other.y; }
+
+	// Unit vector in the same direction, zero vector stays zero. Exact, safe for the simulation.
+	static Vector2 Normalize(const Vector2 vector2)
+	{
+		T lengthSquared = vector2.LengthSquared();
+		if (lengthSquared == 0) return Vector2();
+		T inverseLength = 1 / std::sqrt(lengthSquared);
+		return Vector2(vector2.x * inverseLength, vector2.y * inverseLength);
+	}
+	void Normalize() { *this = Normalize(*this); }
+
+	// Approximate reciprocal square root plus one Newton step (~1e-7 relative error for float).
+	// The estimate instruction differs between CPU vendors, so keep it out of replayed game logic.
+	static Vector2 FastNormalize(const Vector2 vector2)
+	{
+		T lengthSquared = vector2.LengthSquared();
+		if (lengthSquared == 0) return Vector2();
+#ifdef VECTOR2_SSE
+		if constexpr (std::same_as<T, float>) {
+			float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(lengthSquared)));
+			float inverseLength = estimate * (1.5f - 0.5f * lengthSquared * estimate * estimate);
+			return Vector2(vector2.x * inverseLength, vector2.y * inverseLength);
+		}
+#endif
+		return Normalize(vector2);
+	}
+
+	constexpr Vector2 operator*(const Vector2& vector) const { return Vector2(x * vector.x, y * vector.y); }
+	constexpr Vector2 operator*(const T scalar) const { return Vector2(x * scalar, y * scalar); }
+	constexpr Vector2& operator*=(const T scalar)
+	{
+		x *= scalar;
+		y *= scalar;
+		return *this;
+	}
+	// Dividing by zero follows IEEE rules (inf/nan) like any other float division
+	constexpr Vector2 operator/(const T scalar) const { return Vector2(x / scalar, y / scalar); }
+	constexpr Vector2& operator/=(const T scalar)
+	{
+		x /= scalar;
+		y /= scalar;
+		return *this;
+	}
+	constexpr Vector2 operator+(const Vector2& vector) const { return Vector2(x + vector.x, y + vector.y); }
+	constexpr Vector2& operator+=(const Vector2& vector)
+	{
+		x += vector.x;
+		y += vector.y;
+		return *this;
+	}
+	constexpr Vector2 operator-(const Vector2& other) const { return Vector2(x - other.x, y - other.y); }
+	constexpr bool operator==(const Vector2& other) const { return x == other.x && y == other.y; }
+	constexpr bool operator!=(const Vector2& other) const { return !(*this == other); }
+
+	friend std::ostream& operator<<(std::ostream& os, const Vector2& vector)
+	{
+		os << "(" << vector.x << ", " << vector.y << ")";
+		return os;
+	}
+
+	T GetAngleFromNormalizedVector() const
+	{
+		constexpr T kPi = static_cast<T>(3.14159265358979323846);
+		constexpr T kDefaultRotationOffset = 90;
+
+		T angleInRadians = std::atan2(y, x);
+
+		// Convert radians to degrees
+		T angleInDegrees = angleInRadians * (180 / kPi);
+
+		// Adjust the angle: since (0, -1) is 0 degrees, we need to shift by 90 degrees
+		angleInDegrees = std::fmod(angleInDegrees + kDefaultRotationOffset, static_cast<T>(360));
+
+		// If angle is negative, make it positive
+		if (angleInDegrees < 0) {
+			angleInDegrees += 360;
+		}
+
+		return angleInDegrees;
+	}
+};